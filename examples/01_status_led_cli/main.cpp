@@ -13,6 +13,7 @@
 
 #include "examples/common/BoardPins.h"
 #include "examples/common/Log.h"
+#include "StatusLed/Serializer.h"
 #include "StatusLed/StatusLed.h"
 #include "StatusLed/Version.h"
 
@@ -28,6 +29,7 @@ struct StressState {
 };
 
 static StressState g_stress;
+static StatusLed::PackMapping g_packMapping;
 
 static char g_line[128];
 static uint8_t g_line_len = 0;
@@ -90,24 +92,6 @@ static const PresetNameMap kPresets[] = {
   {"lowbat", StatusLed::StatusPreset::LowBattery},
 };
 
-static const char* mode_name(StatusLed::Mode mode) {
-  for (size_t i = 0; i < sizeof(kModes) / sizeof(kModes[0]); ++i) {
-    if (kModes[i].mode == mode) {
-      return kModes[i].name;
-    }
-  }
-  return "unknown";
-}
-
-static const char* preset_name(StatusLed::StatusPreset preset) {
-  for (size_t i = 0; i < sizeof(kPresets) / sizeof(kPresets[0]); ++i) {
-    if (kPresets[i].preset == preset) {
-      return kPresets[i].name;
-    }
-  }
-  return "unknown";
-}
-
 static bool parse_mode(const char* s, StatusLed::Mode* out) {
   for (size_t i = 0; i < sizeof(kModes) / sizeof(kModes[0]); ++i) {
     if (strcmp(kModes[i].name, s) == 0) {
@@ -207,6 +191,7 @@ static void print_help() {
   print_help_item("status [index]", "Show LED snapshot (one or all)");
   print_help_item("config", "Print active configuration");
   print_help_item("last", "Print last driver status");
+  print_help_item("json [since_version]", "Print state (or changes) as JSON");
   print_help_item("list_modes", "List mode names");
   print_help_item("list_presets", "List preset names");
   Serial.println();
@@ -227,6 +212,12 @@ static void print_help() {
   print_help_item("allcolor <r> <g> <b>", "Set color on all LEDs");
   print_help_item("refresh", "Force refresh");
   Serial.println();
+  print_help_section("Pack");
+  print_help_item("pack <partition_label>", "Map and attach a pack partition");
+  print_help_item("packpreset <i> <id>", "Apply pack preset");
+  print_help_item("packpattern <i> <id>", "Run pack pattern");
+  print_help_item("packtrack <i> <id>", "Run pack track");
+  Serial.println();
 }
 
 static void print_config() {
@@ -245,6 +236,10 @@ static void print_config() {
   Serial.println(g_config.smoothStepMs);
 }
 
+static bool serial_sink(const uint8_t* data, size_t len, void*) {
+  return Serial.write(data, len) == len;
+}
+
 static void print_status_one(uint8_t index) {
   StatusLed::LedSnapshot snap;
   const StatusLed::Status st = g_leds.getLedSnapshot(index, &snap);
@@ -255,11 +250,11 @@ static void print_status_one(uint8_t index) {
   Serial.print(F("LED "));
   Serial.print(index);
   Serial.print(F(" mode="));
-  Serial.print(mode_name(snap.mode));
+  Serial.print(StatusLed::modeName(snap.mode));
   Serial.print(F(" preset="));
-  Serial.print(preset_name(snap.preset));
+  Serial.print(StatusLed::presetName(snap.preset));
   Serial.print(F(" default="));
-  Serial.print(preset_name(snap.defaultPreset));
+  Serial.print(StatusLed::presetName(snap.defaultPreset));
   Serial.print(F(" color="));
   Serial.print(snap.color.r);
   Serial.print(F(","));
@@ -276,6 +271,10 @@ static void print_status_one(uint8_t index) {
   Serial.print(snap.brightness);
   Serial.print(F(" intensity="));
   Serial.print(snap.intensity);
+  if (snap.mode == StatusLed::Mode::PackPattern || snap.mode == StatusLed::Mode::PackTrack) {
+    Serial.print(F(" packRef="));
+    Serial.print(snap.packRef);
+  }
   if (snap.tempActive) {
     Serial.print(F(" temp="));
     Serial.print(snap.tempRemainingMs);
@@ -448,6 +447,23 @@ static void handle_command(char* line) {
     return;
   }
 
+  if (strcmp(argv[0], "json") == 0) {
+    StatusLed::SerialOutput out;
+    out.sink = serial_sink;
+    StatusLed::Status st;
+    uint32_t since = 0;
+    if (argc > 1 && parse_u32(argv[1], &since)) {
+      st = StatusLed::serializeChanges(g_leds, since, StatusLed::SerialFormat::Json, &out);
+    } else {
+      st = StatusLed::serializeState(g_leds, StatusLed::SerialFormat::Json, &out);
+    }
+    Serial.println();
+    if (!st.ok()) {
+      LOGE("json failed: %s", st.msg);
+    }
+    return;
+  }
+
   if (strcmp(argv[0], "config") == 0) {
     print_config();
     return;
@@ -647,6 +663,53 @@ static void handle_command(char* line) {
     return;
   }
 
+  if (strcmp(argv[0], "pack") == 0 && argc >= 2) {
+    g_leds.detachPack();
+    StatusLed::unmapPack(&g_packMapping);
+    StatusLed::Status st = StatusLed::mapPackPartition(argv[1], &g_packMapping);
+    if (!st.ok()) {
+      LOGE("pack map failed: %s", st.msg);
+      return;
+    }
+    StatusLed::PackView view;
+    st = StatusLed::PackView::open(g_packMapping.data, g_packMapping.size, &view);
+    if (st.ok()) {
+      st = g_leds.attachPack(view);
+    }
+    if (!st.ok()) {
+      LOGE("pack attach failed: %s (detail=%ld)", st.msg, static_cast<long>(st.detail));
+      StatusLed::unmapPack(&g_packMapping);
+      return;
+    }
+    LOGI("Pack attached: %lu presets, %lu patterns, %lu tracks",
+         static_cast<unsigned long>(view.presetCount()),
+         static_cast<unsigned long>(view.patternCount()),
+         static_cast<unsigned long>(view.trackCount()));
+    return;
+  }
+
+  if ((strcmp(argv[0], "packpreset") == 0 || strcmp(argv[0], "packpattern") == 0 ||
+       strcmp(argv[0], "packtrack") == 0) && argc >= 3) {
+    uint32_t idx = 0;
+    uint32_t id = 0;
+    if (!parse_u32(argv[1], &idx) || !parse_u32(argv[2], &id)) {
+      LOGE("invalid pack args");
+      return;
+    }
+    StatusLed::Status st;
+    if (strcmp(argv[0], "packpreset") == 0) {
+      st = g_leds.setPackPreset(static_cast<uint8_t>(idx), static_cast<uint16_t>(id));
+    } else if (strcmp(argv[0], "packpattern") == 0) {
+      st = g_leds.setPackPattern(static_cast<uint8_t>(idx), static_cast<uint16_t>(id));
+    } else {
+      st = g_leds.setPackTrack(static_cast<uint8_t>(idx), static_cast<uint16_t>(id));
+    }
+    if (!st.ok()) {
+      LOGE("%s failed: %s", argv[0], st.msg);
+    }
+    return;
+  }
+
   if (strcmp(argv[0], "stress") == 0 && argc >= 2) {
     if (strcmp(argv[1], "on") == 0) {
       g_stress.active = true;
@@ -25,6 +25,12 @@ namespace StatusLed {
 #define STATUSLED_BACKEND_NULL 0
 #endif
 
+/// @brief Host test build: replaces the null backend with the simulated wire backend
+/// (hardware backends build against test/mocks instead of ESP-IDF).
+#ifndef STATUSLED_TEST
+#define STATUSLED_TEST 0
+#endif
+
 #if (STATUSLED_BACKEND_IDF_WS2812 != 0 && STATUSLED_BACKEND_IDF_WS2812 != 1)
 #error "STATUSLED_BACKEND_IDF_WS2812 must be 0 or 1"
 #endif
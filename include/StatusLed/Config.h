@@ -10,8 +10,13 @@
 
 #include <stdint.h>
 
+#include "StatusLed/Layout.h"
+
 namespace StatusLed {
 
+/// @brief Most data lines (chains) one engine can drive.
+static constexpr uint8_t kMaxChains = 4;
+
 /// @brief LED color byte order on the wire.
 enum class ColorOrder : uint8_t {
   GRB = 0,  ///< Green, Red, Blue (typical WS2812)
@@ -37,6 +42,16 @@ struct Config {
   /// @note Valid range: 1..10. Validated in begin().
   uint8_t ledCount = 0;
 
+  /// @brief Data pins of further chains, started together with dataPin's (-1 = unused).
+  /// @note LEDs are split into consecutive runs of chainLength: the first on
+  ///       dataPin, the next on chainPins[0], and so on. Set entries in order.
+  /// @note Requires STATUSLED_BACKEND_IDF5_WS2812 (RMT sync manager). Validated in begin().
+  int chainPins[kMaxChains - 1] = {-1, -1, -1};
+
+  /// @brief LEDs per chain when chainPins are used (the last chain may be shorter).
+  /// @note Ignored without chainPins. Every chain must get at least one LED.
+  uint8_t chainLength = 0;
+
   /// @brief Color order of LEDs on the bus.
   ColorOrder colorOrder = ColorOrder::GRB;
 
@@ -51,6 +66,56 @@ struct Config {
   /// @brief Minimum step period for smooth animations in milliseconds.
   /// @note Valid range: 5..1000. Lower values increase CPU usage.
   uint16_t smoothStepMs = 20;
+
+  /// @brief Global frame clock period in milliseconds (0 = per-LED deadlines).
+  /// @note When set, tick() evaluates all animated LEDs from the clock time in
+  ///       one pass once per period and sends at most one frame per period.
+  ///       Urgent frames (Critical or temporary presets) go out between edges,
+  ///       superseding a stale in-flight frame as without the clock.
+  ///       Display acks, stall recovery and power gating still run on every
+  ///       tick. Valid: 0 or 5..1000.
+  uint16_t frameClockMs = 0;
+
+  /// @brief GPIO that enables the LED supply rail (-1 = rail always on).
+  /// @note When set, tick() switches the rail off once an all-black frame is
+  ///       displayed and no LED has pending work, and back on before the next
+  ///       visible frame. Must differ from dataPin. Validated in begin().
+  int powerPin = -1;
+
+  /// @brief powerPin level that turns the rail on.
+  bool powerActiveHigh = true;
+
+  /// @brief Delay between switching the rail on and sending a frame (ms).
+  /// @note Valid range: 0..1000. Covers supply ramp and LED power-on reset.
+  uint16_t powerSettleMs = 2;
+
+  /// @brief Inactivity before output is dimmed, in milliseconds (0 = never).
+  /// @note Counted from the last logical state change (anything that bumps
+  ///       stateVersion()); any new status restores full output at once.
+  ///       Valid range: 0..86400000 (24 h). Validated in begin().
+  uint32_t idleTimeoutMs = 0;
+
+  /// @brief Output scale reached after idleTimeoutMs (0 = blank, 255 = unchanged).
+  /// @note Applied on top of globalBrightness. With 0 and powerPin set, the
+  ///       rail is switched off once the panel is black and no exempt LED
+  ///       animates; blanked LEDs keep animating without powering it.
+  uint8_t idleLevel = 0;
+
+  /// @brief Ramp time from full output down to idleLevel (ms, 0 = step).
+  /// @note Stepped every smoothStepMs. Valid range: 0..60000.
+  uint16_t idleFadeMs = 1000;
+
+  /// @brief LEDs showing a temporary or Critical preset keep full output while idle.
+  bool idleExemptUrgent = true;
+
+  /// @brief Number of shared extension blocks for optional per-LED state.
+  /// @note Valid range: 0..64 (kMaxExtBlocks). Allocated in begin().
+  /// @note One block is held by each LED in Mode::Custom.
+  uint8_t extBlockCount = 4;
+
+  /// @brief Physical arrangement used by spatial effects.
+  /// @note Defaults to a linear strip. Compiled and validated in begin().
+  Layout layout{};
 };
 
 }  // namespace StatusLed
@@ -0,0 +1,87 @@
+/**
+ * @file ExtPool.h
+ * @brief Fixed-size pool of per-LED extension blocks.
+ *
+ * Optional per-LED state (custom evaluator scratch, and future features that
+ * only a few LEDs use at once) lives in blocks borrowed from one pool instead
+ * of worst-case inline space in every LED. The pool is allocated once in
+ * StatusLed::begin(); acquire() and release() are O(1) and never allocate.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "StatusLed/Status.h"
+
+namespace StatusLed {
+
+/// @brief Feature state bytes in one extension block.
+static constexpr size_t kExtStateSize = 16;
+
+/// @brief Size of one extension block in bytes: two pointers (e.g. a callback
+///        and its user pointer) followed by kExtStateSize bytes. Pointer-aligned.
+static constexpr size_t kExtBlockSize = 2 * sizeof(void*) + kExtStateSize;
+
+/// @brief Largest pool accepted by Config::extBlockCount.
+static constexpr uint8_t kMaxExtBlocks = 64;
+
+/// @brief Block index meaning "no block".
+static constexpr uint8_t kNoExtBlock = 0xFF;
+
+/**
+ * @brief Free-list pool of kExtBlockSize-byte blocks addressed by uint8_t index.
+ *
+ * Free blocks store the next free index in their first byte, so the pool has
+ * no per-block bookkeeping beyond a 64-bit in-use mask.
+ */
+class ExtPool {
+ public:
+  ExtPool() = default;
+  ~ExtPool();
+
+  ExtPool(const ExtPool&) = delete;
+  ExtPool& operator=(const ExtPool&) = delete;
+
+  /**
+   * @brief Allocate storage for count blocks, all free.
+   * @param count Number of blocks (0..kMaxExtBlocks, 0 = empty pool).
+   * @return Status Ok, INVALID_CONFIG if count is too large, or OUT_OF_MEMORY.
+   */
+  Status begin(uint8_t count);
+
+  /// @brief Release storage. Outstanding block indices become invalid.
+  void end();
+
+  /**
+   * @brief Take a free block.
+   * @param out Block index output (kNoExtBlock on failure).
+   * @return Status Ok, or OUT_OF_MEMORY when the pool is exhausted.
+   * @note Block contents are undefined; clear them if needed.
+   */
+  Status acquire(uint8_t* out);
+
+  /// @brief Return a block to the pool. Ignores kNoExtBlock and blocks not in use.
+  void release(uint8_t block);
+
+  /// @brief Block storage (kExtBlockSize bytes). Block must be in use.
+  uint8_t* data(uint8_t block) {
+    return reinterpret_cast<uint8_t*>(_storage) + static_cast<size_t>(block) * kExtBlockSize;
+  }
+
+  /// @brief Total number of blocks.
+  uint8_t capacity() const { return _capacity; }
+
+  /// @brief Number of free blocks.
+  uint8_t available() const { return _available; }
+
+ private:
+  uintptr_t* _storage = nullptr;
+  uint64_t _inUse = 0;
+  uint8_t _capacity = 0;
+  uint8_t _available = 0;
+  uint8_t _freeHead = kNoExtBlock;
+};
+
+}  // namespace StatusLed
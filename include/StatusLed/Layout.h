@@ -0,0 +1,94 @@
+/**
+ * @file Layout.h
+ * @brief Physical LED layout (strip, matrix, or explicit map).
+ *
+ * The engine addresses LEDs by strip index. A Layout describes where each
+ * index sits on a grid; begin() compiles it once into index and coordinate
+ * lookup tables so spatial effects never evaluate wiring rules per frame.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "StatusLed/Status.h"
+
+namespace StatusLed {
+
+/// @brief Largest grid accepted by a Layout (width x height cells).
+static constexpr uint8_t kMaxLayoutCells = 64;
+
+/// @brief LEDs covered by a compiled layout (matches StatusLed::kMaxLedCount).
+static constexpr uint8_t kMaxLayoutLeds = 10;
+
+/// @brief Cell or map entry without an LED.
+static constexpr uint8_t kNoLayoutLed = 0xFF;
+
+/// @brief How strip indices map onto the grid.
+enum class LayoutKind : uint8_t {
+  Linear = 0,  ///< One row, index = x
+  Matrix,      ///< Row-major grid, optionally serpentine
+  Map          ///< Explicit cell -> index table
+};
+
+/**
+ * @brief Layout descriptor (part of Config).
+ */
+struct Layout {
+  LayoutKind kind = LayoutKind::Linear;
+
+  /// @brief Grid columns (Matrix/Map). Linear uses ledCount.
+  uint8_t width = 0;
+
+  /// @brief Grid rows (Matrix/Map). Linear uses 1.
+  uint8_t height = 0;
+
+  /// @brief Matrix: odd rows run right to left.
+  bool serpentine = false;
+
+  /// @brief Data enters at the last cell (Matrix/Linear) or last index (Map).
+  bool reversed = false;
+
+  /// @brief Map: width*height row-major entries, strip index or kNoLayoutLed.
+  /// @note Every LED must appear exactly once. Copied by begin(); need not outlive it.
+  const uint8_t* map = nullptr;
+};
+
+/**
+ * @brief Compiled layout: O(1) lookups in both directions.
+ */
+class LayoutTable {
+ public:
+  /**
+   * @brief Compile a layout for ledCount LEDs.
+   * @param layout Descriptor.
+   * @param ledCount Number of LEDs (1..kMaxLayoutLeds).
+   * @return Status Ok, or INVALID_CONFIG (table left as a linear layout).
+   */
+  Status compile(const Layout& layout, uint8_t ledCount);
+
+  uint8_t width() const { return _width; }
+  uint8_t height() const { return _height; }
+
+  /// @brief Strip index at a cell, or kNoLayoutLed (empty or out of range).
+  uint8_t indexAt(uint8_t x, uint8_t y) const {
+    return (x < _width && y < _height) ? _cell[y * _width + x] : kNoLayoutLed;
+  }
+
+  /// @brief Column of a strip index (index must be < ledCount).
+  uint8_t x(uint8_t index) const { return _x[index]; }
+
+  /// @brief Row of a strip index (index must be < ledCount).
+  uint8_t y(uint8_t index) const { return _y[index]; }
+
+ private:
+  void compileLinear(uint8_t ledCount, bool reversed);
+
+  uint8_t _width = 0;
+  uint8_t _height = 0;
+  uint8_t _x[kMaxLayoutLeds]{};
+  uint8_t _y[kMaxLayoutLeds]{};
+  uint8_t _cell[kMaxLayoutCells]{};
+};
+
+}  // namespace StatusLed
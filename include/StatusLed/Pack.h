@@ -0,0 +1,223 @@
+/**
+ * @file Pack.h
+ * @brief Memory-mapped pattern/preset pack format for StatusLed.
+ *
+ * A pack is a compact, versioned, little-endian binary image containing
+ * step patterns, keyframe tracks, color palettes, and presets. The engine
+ * reads it in place through a pointer (typically a memory-mapped flash
+ * partition), so pack contents never consume RAM.
+ *
+ * Packs are produced and checked on the host by scripts/pack_compiler.py.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "StatusLed/Status.h"
+
+namespace StatusLed {
+
+/// @brief Pack magic ("SLPK" when read as little-endian bytes).
+static constexpr uint32_t kPackMagic = 0x4B504C53u;
+
+/// @brief Pack format version understood by this library.
+static constexpr uint16_t kPackFormatVersion = 1;
+
+/// @brief Required alignment of the pack base pointer and all tables.
+static constexpr size_t kPackAlignment = 4;
+
+/// @brief Location of one record table inside a pack.
+struct PackTable {
+  uint32_t offset;  ///< Byte offset from the pack start (multiple of 4)
+  uint32_t count;   ///< Number of records
+};
+
+/**
+ * @brief Pack header, located at offset 0.
+ *
+ * The CRC covers bytes [headerSize, totalSize).
+ */
+struct PackHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t headerSize;
+  uint32_t totalSize;
+  uint32_t crc32;
+  PackTable patterns;   ///< PackPattern[]
+  PackTable steps;      ///< PackStep[]
+  PackTable tracks;     ///< PackTrack[]
+  PackTable keyframes;  ///< PackKeyframe[]
+  PackTable palettes;   ///< PackPalette[]
+  PackTable colors;     ///< PackColor[]
+  PackTable presets;    ///< PackPreset[]
+};
+
+/// @brief PackStep::flags bit: output the secondary color during this step.
+static constexpr uint8_t kPackStepUseAlt = 0x01;
+
+/// @brief One step of a step pattern (same semantics as built-in patterns).
+struct PackStep {
+  uint16_t durationMs;  ///< Step duration, must be > 0
+  uint8_t intensity;    ///< Intensity 0..255
+  uint8_t flags;        ///< kPackStep* bits
+};
+
+/// @brief Repeating step pattern: a slice of the steps table.
+struct PackPattern {
+  uint16_t firstStep;
+  uint16_t stepCount;
+};
+
+/// @brief PackKeyframe::flags bit: hold this value until the next keyframe.
+static constexpr uint8_t kPackKeyHold = 0x01;
+/// @brief PackKeyframe::flags bit: output the secondary color from this keyframe.
+static constexpr uint8_t kPackKeyUseAlt = 0x02;
+
+/// @brief Keyframe of an intensity track.
+struct PackKeyframe {
+  uint16_t timeMs;    ///< Time from track start, strictly increasing
+  uint8_t intensity;  ///< Intensity 0..255
+  uint8_t flags;      ///< kPackKey* bits
+};
+
+/// @brief PackTrack::flags bit: restart the track after durationMs.
+static constexpr uint8_t kPackTrackLoop = 0x01;
+
+/// @brief Keyframe track: a slice of the keyframes table.
+struct PackTrack {
+  uint16_t firstKey;
+  uint16_t keyCount;
+  uint16_t durationMs;  ///< Track length, >= last keyframe time, > 0
+  uint8_t flags;        ///< kPackTrack* bits
+  uint8_t reserved;
+};
+
+/// @brief Palette entry.
+struct PackColor {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  uint8_t reserved;
+};
+
+/// @brief Color palette: a slice of the colors table.
+struct PackPalette {
+  uint16_t firstColor;
+  uint16_t colorCount;
+};
+
+/// @brief Temporal behavior referenced by a pack preset.
+enum class PackPresetKind : uint8_t {
+  BuiltinMode = 0,  ///< ref is a StatusLed::Mode value (default parameters)
+  Pattern = 1,      ///< ref is a pattern index
+  Track = 2         ///< ref is a track index
+};
+
+/// @brief Pack preset: behavior plus palette colors.
+struct PackPreset {
+  uint8_t kind;       ///< PackPresetKind
+  uint8_t reserved;
+  uint16_t ref;       ///< Mode, pattern, or track index (see kind)
+  uint16_t palette;   ///< Palette index
+  uint8_t primary;    ///< Primary color index within the palette
+  uint8_t secondary;  ///< Secondary color index within the palette
+};
+
+static_assert(sizeof(PackTable) == 8, "PackTable layout");
+static_assert(sizeof(PackHeader) == 72, "PackHeader layout");
+static_assert(sizeof(PackStep) == 4, "PackStep layout");
+static_assert(sizeof(PackPattern) == 4, "PackPattern layout");
+static_assert(sizeof(PackKeyframe) == 4, "PackKeyframe layout");
+static_assert(sizeof(PackTrack) == 8, "PackTrack layout");
+static_assert(sizeof(PackColor) == 4, "PackColor layout");
+static_assert(sizeof(PackPalette) == 4, "PackPalette layout");
+static_assert(sizeof(PackPreset) == 8, "PackPreset layout");
+
+/**
+ * @brief Validated, read-only view of a pack image.
+ *
+ * Holds only a pointer; the image must stay mapped for as long as the view
+ * (or any StatusLed it is attached to) is in use.
+ */
+class PackView {
+ public:
+  PackView() = default;
+
+  /**
+   * @brief Validate a pack image and bind a view to it.
+   *
+   * Checks magic, version, bounds, alignment, cross-references, and CRC.
+   * Runs once; lookups afterwards are unchecked array indexing.
+   *
+   * @param data Pack base pointer (4-byte aligned).
+   * @param size Bytes available at data (may exceed the pack size).
+   * @param out View output, left empty on failure.
+   * @return Status Ok on success, or INVALID_CONFIG describing the defect.
+   */
+  static Status open(const void* data, size_t size, PackView* out);
+
+  /// @brief Check if the view is bound to a validated pack.
+  bool valid() const { return _base != nullptr; }
+
+  const PackHeader& header() const { return *reinterpret_cast<const PackHeader*>(_base); }
+
+  uint32_t patternCount() const { return valid() ? header().patterns.count : 0; }
+  uint32_t trackCount() const { return valid() ? header().tracks.count : 0; }
+  uint32_t paletteCount() const { return valid() ? header().palettes.count : 0; }
+  uint32_t presetCount() const { return valid() ? header().presets.count : 0; }
+
+  const PackPattern& pattern(uint16_t id) const { return table<PackPattern>(header().patterns)[id]; }
+  const PackStep& step(uint32_t index) const { return table<PackStep>(header().steps)[index]; }
+  const PackTrack& track(uint16_t id) const { return table<PackTrack>(header().tracks)[id]; }
+  const PackKeyframe& keyframe(uint32_t index) const {
+    return table<PackKeyframe>(header().keyframes)[index];
+  }
+  const PackPalette& palette(uint16_t id) const { return table<PackPalette>(header().palettes)[id]; }
+  const PackColor& color(uint32_t index) const { return table<PackColor>(header().colors)[index]; }
+  const PackPreset& preset(uint16_t id) const { return table<PackPreset>(header().presets)[id]; }
+
+ private:
+  template <typename T>
+  const T* table(const PackTable& t) const {
+    return reinterpret_cast<const T*>(_base + t.offset);
+  }
+
+  const uint8_t* _base = nullptr;
+};
+
+/**
+ * @brief A pack image mapped into the address space.
+ *
+ * Filled by mapPackPartition()/mapPackFile(); release with unmapPack().
+ */
+struct PackMapping {
+  const void* data = nullptr;
+  size_t size = 0;
+  uint32_t handle = 0;  ///< Platform mapping handle (opaque)
+};
+
+/**
+ * @brief Memory-map a data partition holding a pack (ESP32 targets).
+ * @param label Partition label from the partition table.
+ * @param out Mapping output.
+ * @return Status Ok on success, UNSUPPORTED on hosts without partitions.
+ */
+Status mapPackPartition(const char* label, PackMapping* out);
+
+/**
+ * @brief Memory-map a pack file (native host builds).
+ * @param path File path.
+ * @param out Mapping output.
+ * @return Status Ok on success, UNSUPPORTED on targets without a filesystem mmap.
+ */
+Status mapPackFile(const char* path, PackMapping* out);
+
+/**
+ * @brief Release a mapping created by mapPackPartition()/mapPackFile().
+ * @note Safe to call on an empty mapping.
+ */
+void unmapPack(PackMapping* mapping);
+
+}  // namespace StatusLed
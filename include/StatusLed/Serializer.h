@@ -0,0 +1,85 @@
+/**
+ * @file Serializer.h
+ * @brief Streaming JSON/CBOR export of engine state without heap use.
+ *
+ * Output goes to a caller buffer or, through a small stack chunk, to a sink
+ * callback (socket, MQTT client, UART). Enum names come from static tables.
+ *
+ * Document layout (same keys in both formats):
+ * @code
+ * state:   {"version":N,"displayed":N,"leds":[LED,...]}
+ * changes: {"since":N,"version":N,"changes":[LED,...]}
+ * LED:     {"i":0,"v":N,"mode":"solid","preset":"ready","default":"off",
+ *           "color":[r,g,b],"alt":[r,g,b],"bri":255,"int":255,
+ *           "temp":false,"tempMs":0,"pack":0}
+ * @endcode
+ * CBOR uses definite-length maps and arrays, except the changes array,
+ * which is indefinite-length (its size is not known up front).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "StatusLed/StatusLed.h"
+
+namespace StatusLed {
+
+/// @brief Output encoding.
+enum class SerialFormat : uint8_t {
+  Json = 0,
+  Cbor
+};
+
+/// @brief Chunk consumer. Return false to stop serialization.
+using SerialSink = bool (*)(const uint8_t* data, size_t len, void* user);
+
+/**
+ * @brief Serializer destination.
+ *
+ * Set either buffer/capacity or sink; leave both unset to only measure the
+ * output size. JSON written to a buffer is NUL-terminated when it fits (the
+ * terminator is not counted in written).
+ */
+struct SerialOutput {
+  uint8_t* buffer = nullptr;
+  size_t capacity = 0;
+  SerialSink sink = nullptr;
+  void* user = nullptr;
+  size_t written = 0;  ///< Bytes produced (buffer: bytes required, even on overflow)
+};
+
+/// @brief Bytes buffered on the stack before each sink call.
+static constexpr size_t kSerialChunkSize = 64;
+
+/// @brief Lowercase mode name ("blinkslow", "custom", ...) or "unknown".
+const char* modeName(Mode mode);
+
+/// @brief Lowercase preset name ("ready", "lowbat", ...) or "unknown".
+const char* presetName(StatusPreset preset);
+
+/**
+ * @brief Serialize every configured LED.
+ * @param leds Initialized engine.
+ * @param format JSON or CBOR.
+ * @param out Destination; written is set on return.
+ * @return Status Ok, NOT_INITIALIZED, INVALID_CONFIG (bad output),
+ *         OUT_OF_MEMORY (buffer too small; written holds the size needed),
+ *         or EXTERNAL_LIB_ERROR (sink returned false).
+ */
+Status serializeState(const StatusLed& leds, SerialFormat format, SerialOutput* out);
+
+/**
+ * @brief Serialize LEDs whose state changed after a version (see getChangesSince()).
+ * @param leds Initialized engine.
+ * @param sinceVersion Version already seen by the consumer.
+ * @param format JSON or CBOR.
+ * @param out Destination; written is set on return.
+ * @return Status as serializeState().
+ * @note Resume with the document's "version" value.
+ */
+Status serializeChanges(const StatusLed& leds, uint32_t sinceVersion, SerialFormat format,
+                        SerialOutput* out);
+
+}  // namespace StatusLed
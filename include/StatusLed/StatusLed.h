@@ -9,10 +9,14 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "StatusLed/BackendConfig.h"
 #include "StatusLed/Config.h"
+#include "StatusLed/ExtPool.h"
+#include "StatusLed/Layout.h"
+#include "StatusLed/Pack.h"
 #include "StatusLed/Status.h"
 
 namespace StatusLed {
@@ -59,7 +63,11 @@ enum class Mode : uint8_t {
   FlickerCandle,
   Glitch,
   Alternate,
-  SOS
+  SOS,
+  PackPattern,  ///< Step pattern from the attached pack (see setPackPattern())
+  PackTrack,    ///< Keyframe track from the attached pack (see setPackTrack())
+  Custom,       ///< User evaluator function (see setCustomMode())
+  Spatial       ///< Layout-driven effect shared by all LEDs (see setSpatialEffect())
 };
 
 /**
@@ -107,6 +115,112 @@ struct ModeParams {
   uint8_t maxLevel = 255;
 };
 
+/// @brief Bytes of per-LED scratch state owned by a custom evaluator (in its extension block).
+static constexpr size_t kCustomStateSize = kExtStateSize;
+
+/**
+ * @brief Inputs passed to a custom evaluator.
+ */
+struct CustomContext {
+  uint8_t index;             ///< LED index
+  uint32_t modeStartMs;      ///< tick() time the mode was (re)started
+  const ModeParams* params;  ///< Parameters passed to setCustomMode()
+  void* user;                ///< User pointer passed to setCustomMode()
+  uint8_t* state;            ///< kCustomStateSize bytes, zeroed by setCustomMode()
+};
+
+/**
+ * @brief Result of one custom evaluation.
+ */
+struct CustomStep {
+  uint8_t intensity = 0;      ///< Intensity 0..255
+  bool useAlt = false;        ///< Output the secondary color
+  uint32_t nextChangeMs = 0;  ///< Delay until the next evaluation (0 = hold until wakeCustom())
+};
+
+/**
+ * @brief Custom evaluator, called from tick() only when the LED is due.
+ * @note Runs in the tick() context: keep it short and non-blocking.
+ */
+using CustomEvaluator = CustomStep (*)(const CustomContext& ctx, uint32_t now_ms);
+
+/// @brief Spatial effects driven by Config::layout.
+enum class SpatialEffect : uint8_t {
+  RadialPulse = 0,  ///< Rings of light expanding from the origin
+  RowSweep,         ///< Rows light in turn, moving away from originY
+  Ripple            ///< Like RadialPulse, fading with distance from the origin
+};
+
+/**
+ * @brief Spatial effect parameters.
+ *
+ * Every LED runs the same bump-shaped curve (bandMs wide, once per periodMs),
+ * delayed by msPerCell per cell of distance from the origin.
+ */
+struct SpatialParams {
+  uint16_t periodMs = 1500;  ///< Cycle length
+  uint16_t bandMs = 400;     ///< Lit time per LED per cycle (1..periodMs)
+  uint16_t msPerCell = 150;  ///< Delay per cell of distance
+  uint8_t originX = 0;       ///< Origin column (must be inside the layout)
+  uint8_t originY = 0;       ///< Origin row (must be inside the layout)
+};
+
+/**
+ * @brief Complete state of one LED within a Scene.
+ *
+ * A preset entry takes mode and colors from the preset; a mode entry uses
+ * mode, params, and colors as given. Only built-in modes are allowed.
+ * Constructors are constexpr so scene tables can be placed in flash.
+ */
+struct SceneLed {
+  StatusPreset preset;          ///< Off = mode entry
+  Mode mode;
+  ModeParams params;
+  bool useModeDefaults;         ///< Use getModeDefaults(mode) instead of params
+  RgbColor color;
+  RgbColor altColor;
+  uint8_t brightness;
+  StatusPreset defaultPreset;
+
+  /// @brief LED off.
+  constexpr SceneLed() : SceneLed(Mode::Off, RgbColor()) {}
+
+  /// @brief Built-in preset.
+  constexpr SceneLed(StatusPreset presetValue, uint8_t level = 255,
+                     StatusPreset defaultValue = StatusPreset::Off)
+      : preset(presetValue), mode(Mode::Off), params(), useModeDefaults(true), color(),
+        altColor(), brightness(level), defaultPreset(defaultValue) {}
+
+  /// @brief Mode with its default parameters.
+  constexpr SceneLed(Mode modeValue, const RgbColor& primary, const RgbColor& secondary = RgbColor(),
+                     uint8_t level = 255, StatusPreset defaultValue = StatusPreset::Off)
+      : preset(StatusPreset::Off), mode(modeValue), params(), useModeDefaults(true),
+        color(primary), altColor(secondary), brightness(level), defaultPreset(defaultValue) {}
+
+  /// @brief Mode with explicit parameters.
+  constexpr SceneLed(Mode modeValue, const ModeParams& modeParams, const RgbColor& primary,
+                     const RgbColor& secondary = RgbColor(), uint8_t level = 255,
+                     StatusPreset defaultValue = StatusPreset::Off)
+      : preset(StatusPreset::Off), mode(modeValue), params(modeParams), useModeDefaults(false),
+        color(primary), altColor(secondary), brightness(level), defaultPreset(defaultValue) {}
+};
+
+/**
+ * @brief Whole-panel state applied at once by applyScene().
+ *
+ * @code
+ * static const StatusLed::SceneLed kShipping[] = {
+ *     {StatusLed::StatusPreset::Off},
+ *     {StatusLed::Mode::Breathing, StatusLed::RgbColor(0, 0, 64)},
+ * };
+ * static const StatusLed::Scene kShippingScene{kShipping, 2};
+ * @endcode
+ */
+struct Scene {
+  const SceneLed* leds;  ///< One entry per LED, read only during applyScene()
+  uint8_t count;         ///< Must equal Config::ledCount
+};
+
 /**
  * @brief Snapshot of a single LED runtime state.
  */
@@ -120,8 +234,81 @@ struct LedSnapshot {
   uint8_t intensity = 0;
   bool tempActive = false;
   uint32_t tempRemainingMs = 0;
+  uint16_t packRef = 0;  ///< Pattern/track id when mode is PackPattern/PackTrack
+  uint32_t version = 0;  ///< State version of the last logical change
 };
 
+/**
+ * @brief Output-stage counters.
+ */
+struct FrameStats {
+  uint32_t framesSent = 0;     ///< Frames accepted by the backend
+  uint32_t framesAborted = 0;  ///< In-flight frames superseded by an urgent frame
+  uint32_t showErrors = 0;     ///< Backend show() failures other than busy
+  uint32_t txTimeouts = 0;     ///< Transmits whose completion never arrived (recovered)
+  uint32_t powerCuts = 0;      ///< Times the LED rail was switched off (Config::powerPin)
+};
+
+/**
+ * @brief Per-LED current coefficients for power estimates.
+ *
+ * Defaults approximate a 5 V WS2812B; measure your parts for real budgets.
+ */
+struct PowerModel {
+  uint16_t redUa = 12000;    ///< Red channel current at output 255 (uA)
+  uint16_t greenUa = 12000;  ///< Green channel current at output 255 (uA)
+  uint16_t blueUa = 12000;   ///< Blue channel current at output 255 (uA)
+  uint16_t idleUa = 600;     ///< Quiescent current of a dark LED (uA)
+};
+
+/**
+ * @brief Time-averaged output of one LED over one cycle of its mode.
+ */
+struct PowerReport {
+  uint32_t cycleMs = 0;       ///< Averaging window (0 = constant output)
+  uint16_t dutyPermille = 0;  ///< Share of the cycle with any channel lit (0..1000)
+  uint16_t red = 0;           ///< Average red output, 8.8 fixed point (255 = 0xFF00)
+  uint16_t green = 0;         ///< Average green output, 8.8 fixed point
+  uint16_t blue = 0;          ///< Average blue output, 8.8 fixed point
+  uint32_t currentUa = 0;     ///< Estimated average current including idle (uA)
+};
+
+/**
+ * @brief One entry of the change feed returned by getChangesSince().
+ */
+struct LedChange {
+  uint8_t index = 0;
+  uint32_t version = 0;  ///< Resume token: pass the last entry's version next time
+  LedSnapshot snapshot{};
+};
+
+/// @brief Change feed visitor (see forEachChangeSince()); return false to stop.
+using ChangeVisitor = bool (*)(const LedChange& change, void* user);
+
+/**
+ * @brief Confirmation that a state version reached the LEDs.
+ *
+ * Times come from the backend's microsecond clock (0 on backends without
+ * one) and wrap with it.
+ */
+struct DisplayAck {
+  uint32_t frameSeq = 0;     ///< Frame that carried the change (FrameStats::framesSent when sent)
+  uint32_t version = 0;      ///< Newest state version now displayed (see stateVersion())
+  uint32_t changeUs = 0;     ///< Oldest change first displayed by this frame
+  uint32_t displayedUs = 0;  ///< Frame latched on the LEDs
+  uint32_t latencyUs = 0;    ///< API-to-wire latency: displayedUs - changeUs
+};
+
+/// @brief Display acknowledgement callback, called from tick().
+using DisplayAckCallback = void (*)(const DisplayAck& ack, void* user);
+
+/**
+ * @brief Frame completion notification, called from the backend's TX-done
+ *        interrupt (see setFrameDoneCallback()).
+ * @return true if it woke a higher-priority task (IDF5 backend yields on return).
+ */
+using FrameDoneCallback = bool (*)(void* user);
+
 /**
  * @brief Main status LED controller.
  *
@@ -141,6 +328,11 @@ struct LedSnapshot {
  * }
  * @endcode
  *
+ * @note Output keeps at most one pending frame: changes made while the
+ *       backend is busy overwrite the pending frame in place, so the next
+ *       transmit always carries the newest state. Urgent changes (Critical
+ *       preset, temporary preset start) abort an in-flight non-urgent frame
+ *       on backends that support it.
  * @note This class is not thread-safe. Call all methods from the same
  *       task/thread (typically Arduino loop()).
  * @note Do not call from ISRs.
@@ -313,6 +505,102 @@ class StatusLed {
    */
   Status setAllColor(const RgbColor& color);
 
+  /**
+   * @brief Switch every LED to a prebuilt scene.
+   *
+   * The whole scene is validated before any LED changes, then copied in one
+   * pass; the next tick() sends it as a single frame. Cancels temporary presets.
+   *
+   * @param scene Scene with one entry per configured LED.
+   * @return Status Ok, NOT_INITIALIZED, or INVALID_CONFIG (detail = bad entry index;
+   *         the panel is left unchanged).
+   */
+  Status applyScene(const Scene& scene);
+
+  /**
+   * @brief Attach a validated pack for pack presets, patterns, and tracks.
+   * @param pack View from PackView::open(). Its image must outlive the attachment.
+   * @return Status Ok on success, or INVALID_CONFIG if the view is empty.
+   * @note LEDs running a mode from a previously attached pack are turned off.
+   */
+  Status attachPack(const PackView& pack);
+
+  /**
+   * @brief Detach the current pack.
+   * @note LEDs running a pack pattern or track are turned off.
+   */
+  void detachPack();
+
+  /**
+   * @brief Apply a preset from the attached pack.
+   * @param index LED index (0..ledCount-1).
+   * @param presetId Preset index within the pack.
+   * @return Status Ok on success, NOT_INITIALIZED without a pack, or INVALID_CONFIG.
+   * @note Cancels any active temporary preset, like setPreset().
+   */
+  Status setPackPreset(uint8_t index, uint16_t presetId);
+
+  /**
+   * @brief Run a step pattern from the attached pack (color is unchanged).
+   * @param index LED index (0..ledCount-1).
+   * @param patternId Pattern index within the pack.
+   * @return Status Ok on success, NOT_INITIALIZED without a pack, or INVALID_CONFIG.
+   */
+  Status setPackPattern(uint8_t index, uint16_t patternId);
+
+  /**
+   * @brief Run a keyframe track from the attached pack (color is unchanged).
+   * @param index LED index (0..ledCount-1).
+   * @param trackId Track index within the pack.
+   * @return Status Ok on success, NOT_INITIALIZED without a pack, or INVALID_CONFIG.
+   */
+  Status setPackTrack(uint8_t index, uint16_t trackId);
+
+  /**
+   * @brief Drive an LED from a user evaluator function (Mode::Custom).
+   *
+   * The evaluator runs only when the scheduler wakes the LED, i.e. at mode
+   * start and then after each returned nextChangeMs. Built-in modes never go
+   * through the function pointer.
+   *
+   * @param index LED index (0..ledCount-1).
+   * @param evaluator Evaluator function (must not be null).
+   * @param user Opaque pointer handed back in CustomContext::user.
+   * @param params Parameters handed back in CustomContext::params (sanitized like setMode()).
+   * @return Status Ok on success, INVALID_CONFIG on bad index/null evaluator, or
+   *         OUT_OF_MEMORY when no extension block is free (see Config::extBlockCount).
+   * @note The per-LED state area is zeroed on every call. It is an extension
+   *       block held until the LED leaves Mode::Custom.
+   */
+  Status setCustomMode(uint8_t index, CustomEvaluator evaluator, void* user = nullptr,
+                       const ModeParams& params = ModeParams());
+
+  /**
+   * @brief Re-evaluate a Mode::Custom LED on the next tick().
+   *
+   * Use after new input (e.g. a sensor sample) for evaluators that hold.
+   *
+   * @param index LED index (0..ledCount-1).
+   * @return Status Ok on success, or INVALID_CONFIG if the LED is not in Mode::Custom.
+   */
+  Status wakeCustom(uint8_t index);
+
+  /**
+   * @brief Run a spatial effect on all LEDs.
+   *
+   * Per-LED delay and gain tables are computed here from the compiled layout;
+   * each tick an LED only looks up its delay and evaluates the shared curve.
+   * LEDs outside their lit band sleep until it starts.
+   *
+   * @param effect Effect to run.
+   * @param color Primary color for all LEDs.
+   * @param params Timing and origin.
+   * @return Status Ok, or INVALID_CONFIG on an unknown effect, origin outside
+   *         the layout, or invalid timing.
+   */
+  Status setSpatialEffect(SpatialEffect effect, const RgbColor& color,
+                          const SpatialParams& params = SpatialParams());
+
   /**
    * @brief Force output retransmission on next tick().
    * @note Useful after suspected data line noise or external interference.
@@ -327,6 +615,85 @@ class StatusLed {
    */
   Status getLedSnapshot(uint8_t index, LedSnapshot* out) const;
 
+  /**
+   * @brief Get LEDs whose logical state changed after a given version.
+   *
+   * Logical state is preset, default preset, mode, mode parameters, colors,
+   * brightness, and temporary preset activation. Animation progress is not a
+   * change. Runs in O(changed), not O(ledCount).
+   *
+   * @param sinceVersion Version already seen by the caller (0 = everything).
+   * @param out Output array, oldest change first.
+   * @param max Capacity of out.
+   * @param outCount Number of entries written.
+   * @return Status Ok on success, or INVALID_CONFIG on null pointers.
+   * @note If more than max LEDs changed, call again with out[max-1].version.
+   */
+  Status getChangesSince(uint32_t sinceVersion, LedChange* out, uint8_t max,
+                         uint8_t* outCount) const;
+
+  /**
+   * @brief Visit LEDs whose logical state changed after a given version.
+   *
+   * Same feed as getChangesSince(), oldest change first, in one O(changed)
+   * walk and without an output array sized by the caller.
+   *
+   * @param sinceVersion Version already seen by the caller (0 = everything).
+   * @param visit Called once per change; returning false stops the walk.
+   * @param user Passed to visit.
+   * @return Status Ok on success, or INVALID_CONFIG on a null visitor.
+   */
+  Status forEachChangeSince(uint32_t sinceVersion, ChangeVisitor visit, void* user) const;
+
+  /// @brief Engine-wide state version (version of the most recent change).
+  uint32_t stateVersion() const { return _stateVersion; }
+
+  /**
+   * @brief Newest state version confirmed on the LEDs.
+   *
+   * A version is confirmed once the frame carrying it has completed on the
+   * wire (observed by the next tick()). Aborted or stalled frames confirm
+   * nothing; their changes are confirmed by the frame that replaces them.
+   * Changes that do not alter any pixel are confirmed as soon as no frame is
+   * pending. To wait for a change, read stateVersion() right after the call.
+   */
+  uint32_t displayedVersion() const { return _displayedVersion; }
+
+  /// @brief True once the given state version is on the LEDs.
+  bool isDisplayed(uint32_t version) const {
+    return static_cast<int32_t>(version - _displayedVersion) <= 0;  // Wrap-safe
+  }
+
+  /// @brief Most recent display acknowledgement (zeroed until the first one).
+  const DisplayAck& lastDisplayAck() const { return _lastAck; }
+
+  /**
+   * @brief Register a callback for display acknowledgements.
+   * @param callback Called from tick() each time displayedVersion() advances (nullptr = none).
+   * @param user Passed through to the callback.
+   * @note The callback must not call begin() or end().
+   */
+  void setDisplayAckCallback(DisplayAckCallback callback, void* user = nullptr) {
+    _ackCallback = callback;
+    _ackUser = user;
+  }
+
+  /**
+   * @brief Register a callback fired as soon as a frame finishes on the wire.
+   *
+   * Lets the application wake its LED task (e.g. xTaskNotifyFromISR()) and
+   * call tick() right away instead of polling for completion. The engine
+   * itself never waits on it; tick() still confirms frames as before.
+   *
+   * @param callback Runs in interrupt context: keep it short, IRAM-safe, and
+   *        do not call into StatusLed (nullptr = none).
+   * @param user Passed through to the callback.
+   * @return Status Ok, NOT_INITIALIZED, or UNSUPPORTED if the backend has no
+   *         completion interrupt (NeoPixelBus, Null).
+   * @note Cleared by end().
+   */
+  Status setFrameDoneCallback(FrameDoneCallback callback, void* user = nullptr);
+
   /**
    * @brief Get default parameters for a given mode.
    * @param mode Mode to query.
@@ -334,15 +701,70 @@ class StatusLed {
    */
   static ModeParams getModeDefaults(Mode mode);
 
+  /**
+   * @brief Compute the average output and current of a mode analytically.
+   *
+   * Integrates the mode's pattern table or curve over one full cycle using
+   * the same intensity and brightness scaling as the engine; nothing is
+   * rendered. Smooth modes are integrated per millisecond (the engine samples
+   * the same curve every smoothStepMs). FadeIn/FadeOut report their final,
+   * steady level. Candle/Glitch average over the full LFSR sequence.
+   *
+   * @param mode Built-in mode (pack modes are not supported).
+   * @param params Mode parameters (sanitized like setMode()).
+   * @param color Primary color.
+   * @param altColor Secondary color (used by Alternate).
+   * @param brightness Per-LED brightness (0..255).
+   * @param globalBrightness Config::globalBrightness (0..255).
+   * @param model Current coefficients.
+   * @param out Report output.
+   * @return Status Ok, INVALID_CONFIG on null out/unknown mode, or UNSUPPORTED.
+   */
+  static Status estimatePower(Mode mode, const ModeParams& params, const RgbColor& color,
+                              const RgbColor& altColor, uint8_t brightness,
+                              uint8_t globalBrightness, const PowerModel& model,
+                              PowerReport* out);
+
+  /**
+   * @brief Compute the average output and current of a preset analytically.
+   * @param preset Preset to evaluate (default mode parameters and colors).
+   * @param brightness Per-LED brightness (0..255).
+   * @param globalBrightness Config::globalBrightness (0..255).
+   * @param model Current coefficients.
+   * @param out Report output.
+   * @return Status Ok, or INVALID_CONFIG on null out/unknown preset.
+   */
+  static Status estimatePresetPower(StatusPreset preset, uint8_t brightness,
+                                    uint8_t globalBrightness, const PowerModel& model,
+                                    PowerReport* out);
+
   /// @brief Check if library is currently initialized.
   bool isInitialized() const { return _initialized; }
 
   /// @brief Get current configuration.
   const Config& getConfig() const { return _config; }
 
+  /// @brief Compiled Config::layout (index <-> grid position lookups).
+  const LayoutTable& getLayout() const { return _layout; }
+
   /// @brief Get last error status recorded by the library.
   Status getLastStatus() const { return _lastStatus; }
 
+  /// @brief Number of LEDs tick() currently visits (animated or with a temporary preset).
+  uint8_t activeLedCount() const;
+
+  /// @brief False while tick() has the LED rail switched off (see Config::powerPin).
+  bool isLedPowerOn() const { return _powered; }
+
+  /// @brief Current inactivity output scale (255 = full, see Config::idleTimeoutMs).
+  uint8_t idleOutputLevel() const { return _idleScale; }
+
+  /// @brief Number of free extension blocks (see Config::extBlockCount).
+  uint8_t extBlocksAvailable() const { return _ext.available(); }
+
+  /// @brief Get output-stage counters (reset by begin()).
+  const FrameStats& getFrameStats() const { return _frameStats; }
+
   /// @brief Get number of LEDs configured.
   uint8_t ledCount() const { return _config.ledCount; }
 
@@ -362,6 +784,8 @@ class StatusLed {
     uint32_t modeStartMs = 0;
     StatusPreset currentPreset = StatusPreset::Off;
     StatusPreset defaultPreset = StatusPreset::Off;
+    uint16_t packRef = 0;
+    uint16_t packStep = 0;
 
     bool tempActive = false;
     bool tempPending = false;
@@ -375,13 +799,48 @@ class StatusLed {
     RgbColor resumeAltColor{};
     uint8_t resumeBrightness = 255;
     StatusPreset resumePreset = StatusPreset::Off;
+    uint16_t resumePackRef = 0;
+
+    uint8_t ext = kNoExtBlock;  ///< Extension block (custom evaluator binding and state)
 
     uint32_t lfsr = 0xACE1u;
+
+    uint32_t version = 0;
+    uint8_t newer = kNoLed;  ///< Change list link toward the most recent change
+    uint8_t older = kNoLed;  ///< Change list link toward the oldest change
+  };
+
+  static constexpr uint8_t kNoLed = 0xFF;
+
+  struct InFlightFrame {
+    uint32_t seq = 0;
+    uint32_t version = 0;   ///< _stateVersion when sent
+    uint32_t changeUs = 0;  ///< Oldest unconfirmed change the frame carries
+    bool pending = false;   ///< Sent, completion not yet observed
   };
 
   Status setModeInternal(uint8_t index, Mode mode, const ModeParams& params);
   Status setColorInternal(uint8_t index, const RgbColor& color, bool secondary);
   Status applyPresetInternal(uint8_t index, StatusPreset preset);
+  Status checkPackTarget(uint8_t index) const;
+  void stopPackModes();
+  uint32_t updatePackTrack(LedState& led, uint32_t now_ms);
+  bool evaluateAtEdge(uint8_t index, uint32_t now_ms);
+  void markActive(uint8_t index) { _activeMask |= (1u << index); }
+  void releaseExtIfUnused(uint8_t index);
+  void markChanged(uint8_t index);
+  void confirmDisplayed();
+  void discardInFlight();
+  bool gatePower(uint32_t now_ms);
+  void stepIdle(uint32_t now_ms);
+  void refreshAllOutputs();
+  bool idleExempt(const LedState& led) const {
+    return _config.idleExemptUrgent &&
+           (led.tempActive || led.currentPreset == StatusPreset::Critical);
+  }
+  void acknowledge(uint32_t seq, uint32_t version, uint32_t changeUs, uint32_t displayedUs);
+  void fillSnapshot(uint8_t index, LedSnapshot* out) const;
+  uint8_t oldestChangeSince(uint32_t sinceVersion) const;
   void updateLed(uint8_t index, uint32_t now_ms);
   void refreshLedOutput(uint8_t index, uint8_t intensity, bool useAlt);
   void refreshLedOutput(uint8_t index);
@@ -398,9 +857,40 @@ class StatusLed {
   uint32_t _lastTickMs = 0;
   bool _timeSynced = false;
   bool _frameDirty = false;
+  bool _frameUrgent = false;
+  bool _inFlightUrgent = false;
+  FrameStats _frameStats{};
+  uint32_t _stateVersion = 0;
+  uint32_t _displayedVersion = 0;
+  bool _unconfirmed = false;       ///< Changes not yet carried by a pending or displayed frame
+  uint32_t _unconfirmedSinceUs = 0;
+  InFlightFrame _inFlight{};
+  DisplayAck _lastAck{};
+  DisplayAckCallback _ackCallback = nullptr;
+  void* _ackUser = nullptr;
+  uint8_t _changeNewest = kNoLed;
+  uint8_t _changeOldest = kNoLed;
+  uint32_t _activeMask = 0;  ///< Bit i: LED i has a scheduled update or temporary preset
+  uint32_t _nextFrameClockMs = 0;
+  bool _clockFrameDue = false;  ///< Frame clock: this edge's frame not yet sent
+  bool _powered = true;         ///< LED rail on (always true without Config::powerPin)
+  bool _powerSettling = false;  ///< Rail just switched on; frames wait for _powerReadyMs
+  uint32_t _powerReadyMs = 0;
+  uint8_t _idleScale = 255;     ///< Inactivity scale applied to non-exempt LEDs
+  bool _idleArmed = false;      ///< _idleDeadlineMs pending (never set with idleTimeoutMs = 0)
+  bool _idleRamping = false;    ///< Timeout expired; deadline is the next ramp step
+  uint32_t _idleDeadlineMs = 0;
+  uint32_t _idleRampStartMs = 0;
 
   LedState _leds[kMaxLedCount]{};
   RgbColor _frame[kMaxLedCount]{};
+  PackView _pack{};
+  ExtPool _ext;
+  LayoutTable _layout{};
+  SpatialParams _spatial{};
+  uint32_t _spatialStartMs = 0;              ///< Shared time base, so reverted LEDs stay in step
+  uint16_t _spatialDelayMs[kMaxLedCount]{};  ///< Per-LED delay, reduced modulo periodMs
+  uint8_t _spatialGain[kMaxLedCount]{};
   BackendBase* _backend = nullptr;
 };
 
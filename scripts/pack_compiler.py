@@ -0,0 +1,302 @@
+#!/usr/bin/env python3
+"""
+Compile and validate StatusLed pack images (see include/StatusLed/Pack.h).
+
+Usage:
+  python scripts/pack_compiler.py compile packs/site.json -o site.slpk [--header PackIds.h]
+  python scripts/pack_compiler.py validate site.slpk
+
+Source format (JSON, all sections optional, ids assigned in file order):
+
+  {
+    "palettes": { "alarm": [[255, 0, 0], [0, 0, 255]] },
+    "patterns": { "blip": [[60, 255], [940, 0]], "wigwag": [[200, 255], [200, 255, "alt"]] },
+    "tracks":   { "swell": { "durationMs": 2000, "loop": true,
+                             "keys": [[0, 0], [1000, 255], [1500, 255, "hold"]] } },
+    "presets":  { "intruder": { "pattern": "wigwag", "palette": "alarm", "primary": 0, "secondary": 1 },
+                  "idle":     { "mode": "Breathing", "palette": "alarm" } }
+  }
+
+Flash the image into a data partition, e.g.:
+  parttool.py write_partition --partition-name=ledpack --input site.slpk
+"""
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = 0x4B504C53
+FORMAT_VERSION = 1
+ALIGN = 4
+
+HEADER_FMT = "<IHHII" + "II" * 7
+HEADER_SIZE = struct.calcsize(HEADER_FMT)
+TABLES = ["patterns", "steps", "tracks", "keyframes", "palettes", "colors", "presets"]
+
+STEP_FMT = "<HBB"
+PATTERN_FMT = "<HH"
+KEY_FMT = "<HBB"
+TRACK_FMT = "<HHHBB"
+COLOR_FMT = "<BBBB"
+PALETTE_FMT = "<HH"
+PRESET_FMT = "<BBHHBB"
+
+RECORD_FMT = {
+    "patterns": PATTERN_FMT,
+    "steps": STEP_FMT,
+    "tracks": TRACK_FMT,
+    "keyframes": KEY_FMT,
+    "palettes": PALETTE_FMT,
+    "colors": COLOR_FMT,
+    "presets": PRESET_FMT,
+}
+
+STEP_USE_ALT = 0x01
+KEY_HOLD = 0x01
+KEY_USE_ALT = 0x02
+TRACK_LOOP = 0x01
+
+KIND_MODE = 0
+KIND_PATTERN = 1
+KIND_TRACK = 2
+
+# Must match StatusLed::Mode order (built-in modes only).
+MODES = [
+    "Off", "Solid", "Dim", "BlinkSlow", "BlinkFast", "DoubleBlink", "TripleBlink",
+    "Beacon", "Strobe", "FadeIn", "FadeOut", "PulseSoft", "PulseSharp", "Breathing",
+    "Heartbeat", "Throb", "FlickerCandle", "Glitch", "Alternate", "SOS",
+]
+
+
+class PackError(Exception):
+    pass
+
+
+def u8(value, what):
+    if not isinstance(value, int) or not 0 <= value <= 255:
+        raise PackError(f"{what}: expected 0..255, got {value!r}")
+    return value
+
+
+def u16(value, what):
+    if not isinstance(value, int) or not 0 <= value <= 0xFFFF:
+        raise PackError(f"{what}: expected 0..65535, got {value!r}")
+    return value
+
+
+def index_of(names, name, what):
+    if name not in names:
+        raise PackError(f"{what}: unknown name {name!r}")
+    return names.index(name)
+
+
+def compile_pack(src):
+    tables = {name: [] for name in TABLES}
+
+    palette_names = list(src.get("palettes", {}))
+    for name in palette_names:
+        colors = src["palettes"][name]
+        if not colors:
+            raise PackError(f"palette {name}: empty")
+        tables["palettes"].append((len(tables["colors"]), len(colors)))
+        for i, rgb in enumerate(colors):
+            if len(rgb) != 3:
+                raise PackError(f"palette {name}[{i}]: expected [r, g, b]")
+            tables["colors"].append(tuple(u8(c, f"palette {name}[{i}]") for c in rgb) + (0,))
+
+    pattern_names = list(src.get("patterns", {}))
+    for name in pattern_names:
+        steps = src["patterns"][name]
+        if not steps:
+            raise PackError(f"pattern {name}: empty")
+        tables["patterns"].append((len(tables["steps"]), len(steps)))
+        for i, step in enumerate(steps):
+            what = f"pattern {name}[{i}]"
+            duration = u16(step[0], what)
+            if duration == 0:
+                raise PackError(f"{what}: duration must be > 0")
+            flags = STEP_USE_ALT if "alt" in step[2:] else 0
+            tables["steps"].append((duration, u8(step[1], what), flags))
+
+    track_names = list(src.get("tracks", {}))
+    for name in track_names:
+        track = src["tracks"][name]
+        keys = track.get("keys", [])
+        if not keys:
+            raise PackError(f"track {name}: no keys")
+        duration = u16(track.get("durationMs", keys[-1][0]), f"track {name}")
+        if duration == 0:
+            raise PackError(f"track {name}: durationMs must be > 0")
+        flags = TRACK_LOOP if track.get("loop", False) else 0
+        tables["tracks"].append((len(tables["keyframes"]), len(keys), duration, flags, 0))
+        last = -1
+        for i, key in enumerate(keys):
+            what = f"track {name}[{i}]"
+            time = u16(key[0], what)
+            if time <= last or time > duration:
+                raise PackError(f"{what}: key times must increase and be <= durationMs")
+            last = time
+            key_flags = (KEY_HOLD if "hold" in key[2:] else 0) | (KEY_USE_ALT if "alt" in key[2:] else 0)
+            tables["keyframes"].append((time, u8(key[1], what), key_flags))
+
+    preset_names = list(src.get("presets", {}))
+    for name in preset_names:
+        preset = src["presets"][name]
+        what = f"preset {name}"
+        if "pattern" in preset:
+            kind, ref = KIND_PATTERN, index_of(pattern_names, preset["pattern"], what)
+        elif "track" in preset:
+            kind, ref = KIND_TRACK, index_of(track_names, preset["track"], what)
+        elif "mode" in preset:
+            kind, ref = KIND_MODE, index_of(MODES, preset["mode"], what)
+        else:
+            raise PackError(f"{what}: needs one of pattern/track/mode")
+        palette = index_of(palette_names, preset.get("palette"), what)
+        count = tables["palettes"][palette][1]
+        primary = u8(preset.get("primary", 0), what)
+        secondary = u8(preset.get("secondary", 0), what)
+        if primary >= count or secondary >= count:
+            raise PackError(f"{what}: color index outside palette")
+        tables["presets"].append((kind, 0, ref, palette, primary, secondary))
+
+    for name in ("patterns", "tracks", "palettes", "presets"):
+        if len(tables[name]) > 0xFFFF:
+            raise PackError(f"too many {name}")
+    for name in ("steps", "keyframes", "colors"):
+        if len(tables[name]) > 0xFFFF:
+            raise PackError(f"too many {name} (16-bit slice offsets)")
+
+    body = bytearray()
+    locations = []
+    for name in TABLES:
+        offset = HEADER_SIZE + len(body)
+        for record in tables[name]:
+            body += struct.pack(RECORD_FMT[name], *record)
+        while len(body) % ALIGN:
+            body.append(0)
+        locations += [offset if tables[name] else 0, len(tables[name])]
+
+    total = HEADER_SIZE + len(body)
+    crc = zlib.crc32(bytes(body)) & 0xFFFFFFFF
+    header = struct.pack(HEADER_FMT, MAGIC, FORMAT_VERSION, HEADER_SIZE, total, crc, *locations)
+    ids = {"palettes": palette_names, "patterns": pattern_names, "tracks": track_names,
+           "presets": preset_names}
+    return header + bytes(body), ids
+
+
+def read_records(image, offset, count, fmt):
+    size = struct.calcsize(fmt)
+    return [struct.unpack_from(fmt, image, offset + i * size) for i in range(count)]
+
+
+def validate_pack(image):
+    """Mirror of PackView::open(). Returns a summary dict or raises PackError."""
+    if len(image) < HEADER_SIZE:
+        raise PackError("pack too small")
+    fields = struct.unpack_from(HEADER_FMT, image, 0)
+    magic, version, header_size, total, crc = fields[:5]
+    if magic != MAGIC:
+        raise PackError(f"magic mismatch: 0x{magic:08X}")
+    if version != FORMAT_VERSION:
+        raise PackError(f"unsupported version {version}")
+    if header_size < HEADER_SIZE or header_size % ALIGN:
+        raise PackError(f"headerSize invalid: {header_size}")
+    if total < header_size or total > len(image):
+        raise PackError(f"totalSize invalid: {total}")
+    if zlib.crc32(image[header_size:total]) & 0xFFFFFFFF != crc:
+        raise PackError("crc mismatch")
+
+    tables = {}
+    for i, name in enumerate(TABLES):
+        offset, count = fields[5 + 2 * i], fields[6 + 2 * i]
+        size = struct.calcsize(RECORD_FMT[name])
+        if count and (offset % ALIGN or offset < header_size or offset + count * size > total):
+            raise PackError(f"table {name} out of bounds")
+        tables[name] = read_records(image, offset, count, RECORD_FMT[name]) if count else []
+
+    def slice_ok(first, count, table):
+        return count > 0 and first < len(tables[table]) and first + count <= len(tables[table])
+
+    for i, (duration, _, _) in enumerate(tables["steps"]):
+        if duration == 0:
+            raise PackError(f"step {i}: duration is zero")
+    for i, (first, count) in enumerate(tables["patterns"]):
+        if not slice_ok(first, count, "steps"):
+            raise PackError(f"pattern {i}: steps out of range")
+    for i, (first, count, duration, _, _) in enumerate(tables["tracks"]):
+        if not slice_ok(first, count, "keyframes") or duration == 0:
+            raise PackError(f"track {i}: invalid")
+        times = [tables["keyframes"][first + k][0] for k in range(count)]
+        if any(b <= a for a, b in zip(times, times[1:])) or times[-1] > duration:
+            raise PackError(f"track {i}: keyframes unordered")
+    for i, (first, count) in enumerate(tables["palettes"]):
+        if not slice_ok(first, count, "colors"):
+            raise PackError(f"palette {i}: colors out of range")
+    for i, (kind, _, ref, palette, primary, secondary) in enumerate(tables["presets"]):
+        limits = {KIND_MODE: len(MODES), KIND_PATTERN: len(tables["patterns"]),
+                  KIND_TRACK: len(tables["tracks"])}
+        if kind not in limits or ref >= limits[kind]:
+            raise PackError(f"preset {i}: ref invalid")
+        if palette >= len(tables["palettes"]):
+            raise PackError(f"preset {i}: palette invalid")
+        if max(primary, secondary) >= tables["palettes"][palette][1]:
+            raise PackError(f"preset {i}: color invalid")
+
+    return {name: len(records) for name, records in tables.items()} | {"bytes": total}
+
+
+def emit_header(ids, source_name, header_name):
+    lines = [
+        "/**",
+        f" * @file {header_name}",
+        f" * @brief Pack ids generated from {source_name} by scripts/pack_compiler.py.",
+        " */",
+        "",
+        "#pragma once",
+        "",
+        "#include <stdint.h>",
+        "",
+        "namespace PackIds {",
+    ]
+    for section, names in ids.items():
+        for i, name in enumerate(names):
+            ident = "".join(part.capitalize() for part in name.replace("-", "_").split("_"))
+            lines.append(f"static constexpr uint16_t k{section[:-1].capitalize()}{ident} = {i};")
+    lines += ["}  // namespace PackIds", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    comp = sub.add_parser("compile", help="compile a JSON source into a pack image")
+    comp.add_argument("source", type=Path)
+    comp.add_argument("-o", "--output", type=Path, required=True)
+    comp.add_argument("--header", type=Path, help="also write a C++ header with id constants")
+    val = sub.add_parser("validate", help="validate a pack image")
+    val.add_argument("image", type=Path)
+    args = parser.parse_args()
+
+    try:
+        if args.command == "compile":
+            source = json.loads(args.source.read_text(encoding="utf-8"))
+            image, ids = compile_pack(source)
+            summary = validate_pack(image)
+            args.output.write_bytes(image)
+            if args.header:
+                args.header.write_text(emit_header(ids, args.source.name, args.header.name), encoding="utf-8")
+        else:
+            summary = validate_pack(args.image.read_bytes())
+    except (PackError, OSError, ValueError, KeyError, IndexError, TypeError) as exc:
+        print(f"pack error: {exc}", file=sys.stderr)
+        return 1
+
+    print("OK: " + ", ".join(f"{k}={v}" for k, v in summary.items()))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
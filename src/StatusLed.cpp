@@ -8,16 +8,34 @@
 #include "StatusLedInternal.h"
 
 #include <stddef.h>
+#include <string.h>
 
 namespace StatusLed {
 namespace {
 
 static constexpr uint8_t kMaxLeds = StatusLed::kMaxLedCount;
+static_assert(kMaxLeds <= 32, "active set is a 32-bit mask");
+static_assert(kMaxLeds <= kMaxLayoutLeds, "layout tables cover every LED");
 static constexpr uint8_t kDimLevel = 48;  // ~19% brightness
 static constexpr uint16_t kMinSmoothStepMs = 5;
 static constexpr uint16_t kMaxSmoothStepMs = 1000;
 static constexpr uint32_t kMaxDurationMs = 0x7FFFFFFFu;
 static constexpr int kMaxDataPin = 255;
+static constexpr uint16_t kMaxPowerSettleMs = 1000;
+static constexpr uint32_t kMaxIdleTimeoutMs = 86400000u;  // 24 h
+static constexpr uint16_t kMaxIdleFadeMs = 60000;
+
+// Custom evaluator binding and scratch state, kept in the LED's extension block.
+struct CustomBlock {
+  CustomEvaluator fn;
+  void* user;
+  uint8_t state[kCustomStateSize];
+};
+static_assert(sizeof(CustomBlock) <= kExtBlockSize, "custom block fits an extension block");
+
+static CustomBlock* customBlock(ExtPool& pool, uint8_t block) {
+  return reinterpret_cast<CustomBlock*>(pool.data(block));
+}
 
 struct PatternStep {
   uint16_t durationMs;
@@ -159,6 +177,169 @@ static uint8_t lerpU8(uint8_t minVal, uint8_t maxVal, uint16_t pos, uint16_t spa
   return static_cast<uint8_t>(out);
 }
 
+static const PatternStep* patternTable(Mode mode, size_t* count) {
+#define STATUSLED_PATTERN(table) \
+  *count = sizeof(table) / sizeof(table[0]); \
+  return table
+  switch (mode) {
+    case Mode::DoubleBlink:
+      STATUSLED_PATTERN(kPatternDoubleBlink);
+    case Mode::TripleBlink:
+      STATUSLED_PATTERN(kPatternTripleBlink);
+    case Mode::Beacon:
+      STATUSLED_PATTERN(kPatternBeacon);
+    case Mode::Strobe:
+      STATUSLED_PATTERN(kPatternStrobe);
+    case Mode::Heartbeat:
+      STATUSLED_PATTERN(kPatternHeartbeat);
+    case Mode::Alternate:
+      STATUSLED_PATTERN(kPatternPolice);
+    case Mode::SOS:
+      STATUSLED_PATTERN(kPatternSOS);
+    default:
+      *count = 0;
+      return nullptr;
+  }
+#undef STATUSLED_PATTERN
+}
+
+// Blink level at a time offset into the mode (on phase first).
+static bool blinkOnAt(const ModeParams& params, uint32_t elapsed) {
+  if (params.periodMs <= params.onMs) {
+    return true;
+  }
+  return (elapsed % params.periodMs) < params.onMs;
+}
+
+// Step of a repeating pattern at a time offset into it.
+static const PatternStep& patternStepAt(const PatternStep* steps, size_t count, uint32_t elapsed) {
+  uint32_t cycle = 0;
+  for (size_t i = 0; i < count; ++i) {
+    cycle += steps[i].durationMs;
+  }
+  uint32_t t = elapsed % cycle;
+  for (size_t i = 0; i + 1 < count; ++i) {
+    if (t < steps[i].durationMs) {
+      return steps[i];
+    }
+    t -= steps[i].durationMs;
+  }
+  return steps[count - 1];
+}
+
+// Smooth modes: triangle between min/max over periodMs, shaped per mode.
+static uint8_t pulseLevel(Mode mode, const ModeParams& params, uint32_t now_ms) {
+  const uint16_t period = (params.periodMs > 0) ? params.periodMs : 1;
+  const uint16_t phase = static_cast<uint16_t>(now_ms % period);
+  const uint16_t half = period / 2;
+  uint8_t raw = 0;
+  if (phase < half) {
+    raw = lerpU8(params.minLevel, params.maxLevel, phase, half);
+  } else {
+    raw = lerpU8(params.maxLevel, params.minLevel, static_cast<uint16_t>(phase - half), half);
+  }
+  uint8_t shaped = raw;
+  if (mode == Mode::PulseSoft || mode == Mode::Breathing || mode == Mode::Throb) {
+    shaped = ease8InOut(raw);
+    if (mode == Mode::Breathing) {
+      shaped = scale8(shaped, shaped);
+    }
+  }
+  return shaped;
+}
+
+// Spatial modes: eased bump over the first bandMs of each period, shifted by the
+// LED's delay. Outside the band, *sleepMs is the time until the band starts.
+static uint8_t spatialLevel(const SpatialParams& params, uint16_t delayMs, uint8_t gain,
+                            uint32_t elapsedMs, uint32_t* sleepMs) {
+  const uint16_t period = params.periodMs;
+  const uint16_t phase = static_cast<uint16_t>(elapsedMs % period);
+  const uint16_t t = (phase >= delayMs) ? static_cast<uint16_t>(phase - delayMs)
+                                        : static_cast<uint16_t>(phase + period - delayMs);
+  if (t >= params.bandMs) {
+    *sleepMs = static_cast<uint32_t>(period - t);
+    return 0;
+  }
+  *sleepMs = 0;
+  const int32_t offset = 2 * static_cast<int32_t>(t) - params.bandMs;
+  const uint32_t distance = static_cast<uint32_t>(offset < 0 ? -offset : offset);
+  const uint8_t raw = static_cast<uint8_t>(255u - distance * 255u / params.bandMs);
+  return scale8(ease8InOut(raw), gain);
+}
+
+static uint16_t isqrt32(uint32_t value) {
+  uint32_t root = 0;
+  uint32_t bit = 1u << 30;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint16_t>(root);
+}
+
+static uint8_t lfsrNext(uint32_t* lfsr) {
+  if (*lfsr == 0) *lfsr = 0xACE1u;
+  *lfsr = (*lfsr >> 1) ^ (-(static_cast<int32_t>(*lfsr & 1u)) & 0xB400u);
+  return static_cast<uint8_t>(*lfsr & 0xFFu);
+}
+
+static uint8_t flickerLevel(Mode mode, uint8_t rand8) {
+  if (mode == Mode::FlickerCandle) {
+    const uint8_t base = 140;
+    const uint8_t span = 100;
+    return static_cast<uint8_t>(base + (rand8 % span));
+  }
+  return (rand8 < 30) ? 0 : 255;
+}
+
+static uint16_t flickerHoldMs(uint8_t rand8) {
+  return static_cast<uint16_t>(30 + (rand8 % 60));
+}
+
+static RgbColor scaleColor(const RgbColor& base, uint8_t intensity, uint8_t brightness,
+                           uint8_t globalBrightness) {
+  const uint8_t scaled1 = scale8(intensity, brightness);
+  const uint8_t scaled2 = scale8(scaled1, globalBrightness);
+  return RgbColor(scale8(base.r, scaled2), scale8(base.g, scaled2), scale8(base.b, scaled2));
+}
+
+// Time-weighted channel sums for the analytical power estimate.
+struct PowerAccumulator {
+  PowerAccumulator(const RgbColor& primary, const RgbColor& secondary, uint8_t ledBrightness,
+                   uint8_t global)
+      : color(primary), altColor(secondary), brightness(ledBrightness), globalBrightness(global) {}
+
+  RgbColor color;
+  RgbColor altColor;
+  uint8_t brightness;
+  uint8_t globalBrightness;
+  uint64_t red = 0;
+  uint64_t green = 0;
+  uint64_t blue = 0;
+  uint64_t litMs = 0;
+  uint64_t totalMs = 0;
+
+  void add(uint8_t intensity, bool useAlt, uint64_t weightMs) {
+    const RgbColor out =
+        scaleColor(useAlt ? altColor : color, intensity, brightness, globalBrightness);
+    red += out.r * weightMs;
+    green += out.g * weightMs;
+    blue += out.b * weightMs;
+    if (out.r != 0 || out.g != 0 || out.b != 0) {
+      litMs += weightMs;
+    }
+    totalMs += weightMs;
+  }
+};
+
 static uint8_t safeLedCount(uint8_t count) {
   return (count <= kMaxLeds) ? count : kMaxLeds;
 }
@@ -173,6 +354,35 @@ static bool isValidColorOrder(ColorOrder order) {
   }
 }
 
+static Status checkChains(const Config& config) {
+  const uint8_t chains = chainCount(config);
+  for (uint8_t i = 0; i < kMaxChains - 1; ++i) {
+    const int pin = config.chainPins[i];
+    if (i + 1 >= chains) {
+      if (pin >= 0) {
+        return Status(Err::INVALID_CONFIG, pin, "chainPins must be set in order");
+      }
+      continue;
+    }
+    bool clash = pin > kMaxDataPin || pin == config.dataPin || pin == config.powerPin;
+    for (uint8_t j = 0; j < i; ++j) {
+      clash = clash || pin == config.chainPins[j];
+    }
+    if (clash) {
+      return Status(Err::INVALID_CONFIG, pin, "chainPins invalid");
+    }
+  }
+  if (chains == 1) {
+    return Ok();
+  }
+  // Every chain gets at least one LED.
+  const uint16_t len = config.chainLength;
+  if (len == 0 || len * (chains - 1) >= config.ledCount || len * chains < config.ledCount) {
+    return Status(Err::INVALID_CONFIG, config.chainLength, "chainLength does not match chainPins");
+  }
+  return Ok();
+}
+
 static ModeParams sanitizeParams(Mode mode, ModeParams params) {
   if (params.periodMs < 2) {
     params.periodMs = 2;
@@ -193,35 +403,6 @@ static ModeParams sanitizeParams(Mode mode, ModeParams params) {
   }
   return params;
 }
-
-static bool isValidMode(Mode mode) {
-  switch (mode) {
-    case Mode::Off:
-    case Mode::Solid:
-    case Mode::Dim:
-    case Mode::BlinkSlow:
-    case Mode::BlinkFast:
-    case Mode::DoubleBlink:
-    case Mode::TripleBlink:
-    case Mode::Beacon:
-    case Mode::Strobe:
-    case Mode::FadeIn:
-    case Mode::FadeOut:
-    case Mode::PulseSoft:
-    case Mode::PulseSharp:
-    case Mode::Breathing:
-    case Mode::Heartbeat:
-    case Mode::Throb:
-    case Mode::FlickerCandle:
-    case Mode::Glitch:
-    case Mode::Alternate:
-    case Mode::SOS:
-      return true;
-    default:
-      return false;
-  }
-}
-
 }  // namespace
 
 Status StatusLed::begin(const Config& config) {
@@ -240,13 +421,52 @@ Status StatusLed::begin(const Config& config) {
   if (config.smoothStepMs < kMinSmoothStepMs || config.smoothStepMs > kMaxSmoothStepMs) {
     return setLast(Status(Err::INVALID_CONFIG, config.smoothStepMs, "smoothStepMs out of range"));
   }
+  if (config.frameClockMs != 0 &&
+      (config.frameClockMs < kMinSmoothStepMs || config.frameClockMs > kMaxSmoothStepMs)) {
+    return setLast(Status(Err::INVALID_CONFIG, config.frameClockMs, "frameClockMs out of range"));
+  }
+  if (config.powerPin > kMaxDataPin || (config.powerPin >= 0 && config.powerPin == config.dataPin)) {
+    return setLast(Status(Err::INVALID_CONFIG, config.powerPin, "powerPin invalid"));
+  }
+  const Status chainSt = checkChains(config);
+  if (!chainSt.ok()) {
+    return setLast(chainSt);
+  }
+  if (config.powerSettleMs > kMaxPowerSettleMs) {
+    return setLast(Status(Err::INVALID_CONFIG, config.powerSettleMs, "powerSettleMs out of range"));
+  }
+  if (config.idleTimeoutMs > kMaxIdleTimeoutMs) {
+    return setLast(Status(Err::INVALID_CONFIG, static_cast<int32_t>(config.idleTimeoutMs),
+                          "idleTimeoutMs out of range"));
+  }
+  if (config.idleFadeMs > kMaxIdleFadeMs) {
+    return setLast(Status(Err::INVALID_CONFIG, config.idleFadeMs, "idleFadeMs out of range"));
+  }
+  if (config.extBlockCount > kMaxExtBlocks) {
+    return setLast(Status(Err::INVALID_CONFIG, config.extBlockCount, "extBlockCount out of range"));
+  }
+  LayoutTable layout;
+  const Status layoutSt = layout.compile(config.layout, config.ledCount);
+  if (!layoutSt.ok()) {
+    return setLast(layoutSt);
+  }
 
   end();
 
   _config = config;
+  _config.layout.map = nullptr;  // Compiled below; the caller's table need not outlive begin()
+  _layout = layout;
   _lastTickMs = 0;
   _timeSynced = false;
   _frameDirty = false;
+  _frameUrgent = false;
+  _inFlightUrgent = false;
+  _frameStats = FrameStats();
+  _powered = true;  // Backend begin() switches the rail on
+  _powerSettling = false;
+  _idleScale = 255;
+  _idleArmed = false;
+  _idleRamping = false;
 
   for (uint8_t i = 0; i < kMaxLeds; ++i) {
     _leds[i] = LedState();
@@ -255,8 +475,23 @@ Status StatusLed::begin(const Config& config) {
     _frame[i] = kColorOff;
   }
 
+  _activeMask = (1u << safeLedCount(_config.ledCount)) - 1u;
+
+  // Versions stay monotonic across begin() so remote readers resync cleanly.
+  _changeNewest = kNoLed;
+  _changeOldest = kNoLed;
+  for (uint8_t i = 0; i < safeLedCount(_config.ledCount); ++i) {
+    markChanged(i);
+  }
+
+  const Status extSt = _ext.begin(_config.extBlockCount);
+  if (!extSt.ok()) {
+    return setLast(extSt);
+  }
+
   _backend = createBackend();
   if (_backend == nullptr) {
+    _ext.end();
     return setLast(Status(Err::OUT_OF_MEMORY, 0, "backend alloc failed"));
   }
 
@@ -264,11 +499,16 @@ Status StatusLed::begin(const Config& config) {
   if (!st.ok()) {
     destroyBackend(_backend);
     _backend = nullptr;
+    _ext.end();
     return setLast(st);
   }
 
   _initialized = true;
   _frameDirty = true;
+  _inFlight = InFlightFrame();
+  _lastAck = DisplayAck();
+  _unconfirmed = true;
+  _unconfirmedSinceUs = _backend->nowUs();
   return setLast(Ok());
 }
 
@@ -278,10 +518,18 @@ void StatusLed::end() {
     destroyBackend(_backend);
     _backend = nullptr;
   }
+  _ext.end();
   _initialized = false;
   _timeSynced = false;
 }
 
+Status StatusLed::setFrameDoneCallback(FrameDoneCallback callback, void* user) {
+  if (!_initialized || _backend == nullptr) {
+    return setLast(Status(Err::NOT_INITIALIZED, 0, "begin not called"));
+  }
+  return setLast(_backend->setDoneCallback(callback, user));
+}
+
 ModeParams StatusLed::getModeDefaults(Mode mode) {
   ModeParams params;
   switch (mode) {
@@ -332,6 +580,99 @@ ModeParams StatusLed::getModeDefaults(Mode mode) {
   return params;
 }
 
+Status StatusLed::estimatePower(Mode mode, const ModeParams& params, const RgbColor& color,
+                                const RgbColor& altColor, uint8_t brightness,
+                                uint8_t globalBrightness, const PowerModel& model,
+                                PowerReport* out) {
+  if (out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "out must not be null");
+  }
+  *out = PowerReport();
+  if (mode == Mode::PackPattern || mode == Mode::PackTrack || mode == Mode::Custom ||
+      mode == Mode::Spatial) {
+    return Status(Err::UNSUPPORTED, static_cast<int32_t>(mode), "mode not estimated");
+  }
+  if (!isValidMode(mode)) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(mode), "Unknown mode");
+  }
+
+  const ModeParams p = sanitizeParams(mode, params);
+  PowerAccumulator acc(color, altColor, brightness, globalBrightness);
+  bool cyclic = true;
+  switch (mode) {
+    case Mode::Off:
+    case Mode::FadeOut:
+      acc.add(0, false, 1);
+      cyclic = false;
+      break;
+    case Mode::Solid:
+    case Mode::FadeIn:
+      acc.add(255, false, 1);
+      cyclic = false;
+      break;
+    case Mode::Dim:
+      acc.add(kDimLevel, false, 1);
+      cyclic = false;
+      break;
+    case Mode::BlinkSlow:
+    case Mode::BlinkFast:
+      acc.add(255, false, p.onMs);
+      acc.add(0, false, p.periodMs - p.onMs);
+      break;
+    case Mode::PulseSoft:
+    case Mode::PulseSharp:
+    case Mode::Breathing:
+    case Mode::Throb:
+      for (uint32_t t = 0; t < p.periodMs; ++t) {
+        acc.add(pulseLevel(mode, p, t), false, 1);
+      }
+      break;
+    case Mode::FlickerCandle:
+    case Mode::Glitch:
+      // The maximal-length LFSR visits every nonzero 16-bit state once per
+      // cycle, so each low byte occurs 256 times (0 occurs 255 times).
+      for (uint16_t rand8 = 0; rand8 <= 0xFF; ++rand8) {
+        const uint32_t occurrences = (rand8 == 0) ? 255u : 256u;
+        const uint8_t r = static_cast<uint8_t>(rand8);
+        acc.add(flickerLevel(mode, r), false, occurrences * flickerHoldMs(r));
+      }
+      break;
+    default: {
+      size_t stepCount = 0;
+      const PatternStep* steps = patternTable(mode, &stepCount);
+      for (size_t i = 0; i < stepCount; ++i) {
+        acc.add(steps[i].intensity, steps[i].useAlt, steps[i].durationMs);
+      }
+    } break;
+  }
+
+  const uint64_t total = acc.totalMs;
+  out->cycleMs = cyclic ? static_cast<uint32_t>(total) : 0;
+  out->dutyPermille = static_cast<uint16_t>((acc.litMs * 1000u + total / 2) / total);
+  out->red = static_cast<uint16_t>((acc.red * 256u + total / 2) / total);
+  out->green = static_cast<uint16_t>((acc.green * 256u + total / 2) / total);
+  out->blue = static_cast<uint16_t>((acc.blue * 256u + total / 2) / total);
+  const uint64_t channelUa =
+      acc.red * model.redUa + acc.green * model.greenUa + acc.blue * model.blueUa;
+  out->currentUa = model.idleUa + static_cast<uint32_t>((channelUa + total * 255u / 2) /
+                                                        (total * 255u));
+  return Ok();
+}
+
+Status StatusLed::estimatePresetPower(StatusPreset preset, uint8_t brightness,
+                                      uint8_t globalBrightness, const PowerModel& model,
+                                      PowerReport* out) {
+  const PresetDef* def = findPreset(preset);
+  if (def == nullptr) {
+    if (out != nullptr) {
+      *out = PowerReport();
+    }
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(preset), "Unknown preset");
+  }
+  return estimatePower(def->mode, getModeDefaults(def->mode), def->primary, def->secondary,
+                       brightness, globalBrightness, model, out);
+}
+
 Status StatusLed::setMode(uint8_t index, Mode mode) {
   return setMode(index, mode, getModeDefaults(mode));
 }
@@ -400,7 +741,10 @@ Status StatusLed::setDefaultPreset(uint8_t index, StatusPreset preset) {
     return setLast(Status(Err::INVALID_CONFIG, static_cast<int32_t>(preset), "Unknown preset"));
   }
 
-  _leds[index].defaultPreset = preset;
+  if (_leds[index].defaultPreset != preset) {
+    _leds[index].defaultPreset = preset;
+    markChanged(index);
+  }
 
   if (_leds[index].currentPreset == StatusPreset::Off && _leds[index].mode == Mode::Off) {
     const Status st = applyPresetInternal(index, preset);
@@ -431,6 +775,7 @@ Status StatusLed::setTemporaryPreset(uint8_t index, StatusPreset preset, uint32_
   led.tempPreset = preset;
   led.tempDurationMs = durationMs;
   led.tempPending = true;
+  markActive(index);
 
   return setLast(Ok());
 }
@@ -443,7 +788,10 @@ Status StatusLed::setBrightness(uint8_t index, uint8_t level) {
     return setLast(Status(Err::INVALID_CONFIG, index, "index out of range"));
   }
 
-  _leds[index].brightness = level;
+  if (_leds[index].brightness != level) {
+    _leds[index].brightness = level;
+    markChanged(index);
+  }
   refreshLedOutput(index);
   return setLast(Ok());
 }
@@ -454,10 +802,7 @@ Status StatusLed::setGlobalBrightness(uint8_t level) {
   }
 
   _config.globalBrightness = level;
-  const uint8_t count = safeLedCount(_config.ledCount);
-  for (uint8_t i = 0; i < count; ++i) {
-    refreshLedOutput(i);
-  }
+  refreshAllOutputs();
   return setLast(Ok());
 }
 
@@ -507,12 +852,17 @@ Status StatusLed::clearTemporary(uint8_t index) {
   led.altColor = led.resumeAltColor;
   led.brightness = led.resumeBrightness;
   led.currentPreset = led.resumePreset;
+  led.packRef = led.resumePackRef;
+  led.packStep = 0;
   led.phase = 0;
   led.useAlt = false;
   led.modeStartMs = _lastTickMs;
   led.nextUpdateMs = _lastTickMs;
   led.updateScheduled = true;
   led.phaseEndMs = _lastTickMs;
+  markActive(index);
+  releaseExtIfUnused(index);
+  markChanged(index);
   refreshLedOutput(index);
   return setLast(Ok());
 }
@@ -567,6 +917,218 @@ Status StatusLed::setAllColor(const RgbColor& color) {
   return setLast(Ok());
 }
 
+Status StatusLed::applyScene(const Scene& scene) {
+  if (!_initialized) {
+    return setLast(Status(Err::NOT_INITIALIZED, 0, "begin not called"));
+  }
+  if (scene.leds == nullptr) {
+    return setLast(Status(Err::INVALID_CONFIG, 0, "scene leds must not be null"));
+  }
+  const uint8_t count = safeLedCount(_config.ledCount);
+  if (scene.count != count) {
+    return setLast(Status(Err::INVALID_CONFIG, scene.count, "scene size must equal ledCount"));
+  }
+  // Validate everything first so a bad scene never leaves a half-applied panel.
+  for (uint8_t i = 0; i < count; ++i) {
+    const SceneLed& entry = scene.leds[i];
+    const bool valid = (entry.preset != StatusPreset::Off) ? findPreset(entry.preset) != nullptr
+                                                          : isValidMode(entry.mode);
+    if (!valid || findPreset(entry.defaultPreset) == nullptr) {
+      return setLast(Status(Err::INVALID_CONFIG, i, "scene entry invalid"));
+    }
+  }
+
+  for (uint8_t i = 0; i < count; ++i) {
+    const SceneLed& entry = scene.leds[i];
+    LedState& led = _leds[i];
+    led.tempActive = false;
+    led.tempPending = false;
+    led.defaultPreset = entry.defaultPreset;
+    led.brightness = entry.brightness;
+    if (entry.preset != StatusPreset::Off) {
+      applyPresetInternal(i, entry.preset);
+      continue;
+    }
+    led.currentPreset = StatusPreset::Off;
+    led.color = entry.color;
+    led.altColor = entry.altColor;
+    setModeInternal(i, entry.mode,
+                    entry.useModeDefaults ? getModeDefaults(entry.mode) : entry.params);
+    refreshLedOutput(i);
+  }
+  return setLast(Ok());
+}
+
+Status StatusLed::attachPack(const PackView& pack) {
+  if (!pack.valid()) {
+    return setLast(Status(Err::INVALID_CONFIG, 0, "pack view not valid"));
+  }
+  stopPackModes();
+  _pack = pack;
+  return setLast(Ok());
+}
+
+void StatusLed::detachPack() {
+  stopPackModes();
+  _pack = PackView();
+}
+
+Status StatusLed::setPackPreset(uint8_t index, uint16_t presetId) {
+  const Status check = checkPackTarget(index);
+  if (!check.ok()) {
+    return setLast(check);
+  }
+  if (presetId >= _pack.presetCount()) {
+    return setLast(Status(Err::INVALID_CONFIG, presetId, "pack preset out of range"));
+  }
+
+  const PackPreset& def = _pack.preset(presetId);
+  const PackPalette& pal = _pack.palette(def.palette);
+  const PackColor& primary = _pack.color(static_cast<uint32_t>(pal.firstColor) + def.primary);
+  const PackColor& secondary = _pack.color(static_cast<uint32_t>(pal.firstColor) + def.secondary);
+
+  LedState& led = _leds[index];
+  led.tempActive = false;
+  led.tempPending = false;
+  led.currentPreset = StatusPreset::Off;
+  led.color = RgbColor(primary.r, primary.g, primary.b);
+  led.altColor = RgbColor(secondary.r, secondary.g, secondary.b);
+  led.packRef = def.ref;
+
+  switch (static_cast<PackPresetKind>(def.kind)) {
+    case PackPresetKind::Pattern:
+      setModeInternal(index, Mode::PackPattern, ModeParams{});
+      break;
+    case PackPresetKind::Track:
+      setModeInternal(index, Mode::PackTrack, ModeParams{});
+      break;
+    default: {
+      const Mode mode = static_cast<Mode>(def.ref);
+      setModeInternal(index, mode, getModeDefaults(mode));
+      led.packRef = 0;
+    } break;
+  }
+  refreshLedOutput(index);
+  return setLast(Ok());
+}
+
+Status StatusLed::setPackPattern(uint8_t index, uint16_t patternId) {
+  const Status check = checkPackTarget(index);
+  if (!check.ok()) {
+    return setLast(check);
+  }
+  if (patternId >= _pack.patternCount()) {
+    return setLast(Status(Err::INVALID_CONFIG, patternId, "pack pattern out of range"));
+  }
+  _leds[index].currentPreset = StatusPreset::Off;
+  _leds[index].packRef = patternId;
+  return setLast(setModeInternal(index, Mode::PackPattern, ModeParams{}));
+}
+
+Status StatusLed::setPackTrack(uint8_t index, uint16_t trackId) {
+  const Status check = checkPackTarget(index);
+  if (!check.ok()) {
+    return setLast(check);
+  }
+  if (trackId >= _pack.trackCount()) {
+    return setLast(Status(Err::INVALID_CONFIG, trackId, "pack track out of range"));
+  }
+  _leds[index].currentPreset = StatusPreset::Off;
+  _leds[index].packRef = trackId;
+  return setLast(setModeInternal(index, Mode::PackTrack, ModeParams{}));
+}
+
+Status StatusLed::setCustomMode(uint8_t index, CustomEvaluator evaluator, void* user,
+                                const ModeParams& params) {
+  if (!_initialized) {
+    return setLast(Status(Err::NOT_INITIALIZED, 0, "begin not called"));
+  }
+  if (!indexValid(index)) {
+    return setLast(Status(Err::INVALID_CONFIG, index, "index out of range"));
+  }
+  if (evaluator == nullptr) {
+    return setLast(Status(Err::INVALID_CONFIG, 0, "evaluator must not be null"));
+  }
+  LedState& led = _leds[index];
+  if (led.ext == kNoExtBlock) {
+    const Status st = _ext.acquire(&led.ext);
+    if (!st.ok()) {
+      return setLast(st);
+    }
+  }
+  CustomBlock* custom = customBlock(_ext, led.ext);
+  custom->fn = evaluator;
+  custom->user = user;
+  memset(custom->state, 0, sizeof(custom->state));
+  led.currentPreset = StatusPreset::Off;
+  return setLast(setModeInternal(index, Mode::Custom, params));
+}
+
+Status StatusLed::wakeCustom(uint8_t index) {
+  if (!_initialized) {
+    return setLast(Status(Err::NOT_INITIALIZED, 0, "begin not called"));
+  }
+  if (!indexValid(index)) {
+    return setLast(Status(Err::INVALID_CONFIG, index, "index out of range"));
+  }
+  LedState& led = _leds[index];
+  if (led.mode != Mode::Custom) {
+    return setLast(Status(Err::INVALID_CONFIG, index, "LED not in custom mode"));
+  }
+  led.nextUpdateMs = _lastTickMs;
+  led.updateScheduled = true;
+  markActive(index);
+  return setLast(Ok());
+}
+
+Status StatusLed::setSpatialEffect(SpatialEffect effect, const RgbColor& color,
+                                   const SpatialParams& params) {
+  if (!_initialized) {
+    return setLast(Status(Err::NOT_INITIALIZED, 0, "begin not called"));
+  }
+  if (effect != SpatialEffect::RadialPulse && effect != SpatialEffect::RowSweep &&
+      effect != SpatialEffect::Ripple) {
+    return setLast(Status(Err::INVALID_CONFIG, static_cast<int32_t>(effect), "Unknown spatial effect"));
+  }
+  if (params.originX >= _layout.width() || params.originY >= _layout.height()) {
+    return setLast(Status(Err::INVALID_CONFIG, 0, "spatial origin outside layout"));
+  }
+  if (params.periodMs < 2 || params.bandMs == 0 || params.bandMs > params.periodMs) {
+    return setLast(Status(Err::INVALID_CONFIG, params.bandMs, "spatial timing invalid"));
+  }
+
+  // Distance from the origin in 1/16 cells.
+  const uint8_t count = safeLedCount(_config.ledCount);
+  uint16_t dist16[kMaxLeds];
+  uint16_t maxDist16 = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    const int32_t dx = static_cast<int32_t>(_layout.x(i)) - params.originX;
+    const int32_t dy = static_cast<int32_t>(_layout.y(i)) - params.originY;
+    if (effect == SpatialEffect::RowSweep) {
+      dist16[i] = static_cast<uint16_t>((dy < 0 ? -dy : dy) * 16);
+    } else {
+      dist16[i] = isqrt32(static_cast<uint32_t>(dx * dx + dy * dy) * 256u);
+    }
+    maxDist16 = (dist16[i] > maxDist16) ? dist16[i] : maxDist16;
+  }
+  for (uint8_t i = 0; i < count; ++i) {
+    const uint32_t delay = static_cast<uint32_t>(dist16[i]) * params.msPerCell / 16u;
+    _spatialDelayMs[i] = static_cast<uint16_t>(delay % params.periodMs);
+    _spatialGain[i] = (effect == SpatialEffect::Ripple)
+                          ? static_cast<uint8_t>(255u - 255u * dist16[i] / (maxDist16 + 16u))
+                          : 255;
+  }
+  _spatial = params;
+  _spatialStartMs = _lastTickMs;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    _leds[i].currentPreset = StatusPreset::Off;
+    setModeInternal(i, Mode::Spatial, ModeParams());
+    setColorInternal(i, color, false);
+  }
+  return setLast(Ok());
+}
+
 void StatusLed::forceRefresh() {
   if (_initialized) {
     _frameDirty = true;
@@ -584,6 +1146,109 @@ Status StatusLed::getLedSnapshot(uint8_t index, LedSnapshot* out) const {
     return Status(Err::INVALID_CONFIG, index, "index out of range");
   }
 
+  fillSnapshot(index, out);
+  return Ok();
+}
+
+Status StatusLed::getChangesSince(uint32_t sinceVersion, LedChange* out, uint8_t max,
+                                  uint8_t* outCount) const {
+  if (out == nullptr || outCount == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "out/outCount must not be null");
+  }
+  *outCount = 0;
+  if (!_initialized) {
+    return Status(Err::NOT_INITIALIZED, 0, "begin not called");
+  }
+
+  // Emit oldest-first so a truncated read can resume from the last version.
+  uint8_t count = 0;
+  for (uint8_t i = oldestChangeSince(sinceVersion); i != kNoLed && count < max;
+       i = _leds[i].newer) {
+    out[count].index = i;
+    out[count].version = _leds[i].version;
+    fillSnapshot(i, &out[count].snapshot);
+    ++count;
+  }
+  *outCount = count;
+  return Ok();
+}
+
+Status StatusLed::forEachChangeSince(uint32_t sinceVersion, ChangeVisitor visit,
+                                     void* user) const {
+  if (visit == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "visit must not be null");
+  }
+  if (!_initialized) {
+    return Status(Err::NOT_INITIALIZED, 0, "begin not called");
+  }
+
+  LedChange change;
+  for (uint8_t i = oldestChangeSince(sinceVersion); i != kNoLed; i = _leds[i].newer) {
+    change.index = i;
+    change.version = _leds[i].version;
+    fillSnapshot(i, &change.snapshot);
+    if (!visit(change, user)) {
+      break;
+    }
+  }
+  return Ok();
+}
+
+uint8_t StatusLed::oldestChangeSince(uint32_t sinceVersion) const {
+  // Walk from the newest change to the oldest one still newer than sinceVersion.
+  uint8_t oldest = kNoLed;
+  for (uint8_t i = _changeNewest; i != kNoLed; i = _leds[i].older) {
+    if (static_cast<int32_t>(_leds[i].version - sinceVersion) <= 0) {
+      break;
+    }
+    oldest = i;
+  }
+  return oldest;
+}
+
+void StatusLed::markChanged(uint8_t index) {
+  LedState& led = _leds[index];
+  led.version = ++_stateVersion;
+  if (_config.idleTimeoutMs != 0) {
+    // Activity: back to full output now, and restart the inactivity timer.
+    _idleArmed = true;
+    _idleRamping = false;
+    _idleDeadlineMs = _lastTickMs + _config.idleTimeoutMs;
+    if (_idleScale != 255) {
+      _idleScale = 255;
+      refreshAllOutputs();
+    }
+  }
+  if (!_unconfirmed) {
+    _unconfirmed = true;
+    _unconfirmedSinceUs = (_backend != nullptr) ? _backend->nowUs() : 0;
+  }
+  if (_changeNewest == index) {
+    return;
+  }
+
+  // Unlink (no-op for LEDs not yet in the list), then push as newest.
+  if (led.newer != kNoLed) {
+    _leds[led.newer].older = led.older;
+  }
+  if (led.older != kNoLed) {
+    _leds[led.older].newer = led.newer;
+  }
+  if (_changeOldest == index) {
+    _changeOldest = led.newer;
+  }
+  led.older = _changeNewest;
+  led.newer = kNoLed;
+  if (_changeNewest != kNoLed) {
+    _leds[_changeNewest].newer = index;
+  }
+  _changeNewest = index;
+  if (_changeOldest == kNoLed) {
+    _changeOldest = index;
+  }
+}
+
+void StatusLed::fillSnapshot(uint8_t index, LedSnapshot* out) const {
   const LedState& led = _leds[index];
   out->mode = led.mode;
   out->preset = led.currentPreset;
@@ -593,6 +1258,8 @@ Status StatusLed::getLedSnapshot(uint8_t index, LedSnapshot* out) const {
   out->brightness = led.brightness;
   out->intensity = led.intensity;
   out->tempActive = led.tempActive;
+  out->packRef = led.packRef;
+  out->version = led.version;
   if (led.tempActive && timeReached(_lastTickMs, led.tempUntilMs)) {
     out->tempRemainingMs = 0;
   } else if (led.tempActive) {
@@ -600,29 +1267,69 @@ Status StatusLed::getLedSnapshot(uint8_t index, LedSnapshot* out) const {
   } else {
     out->tempRemainingMs = 0;
   }
+}
 
+Status StatusLed::checkPackTarget(uint8_t index) const {
+  if (!_initialized) {
+    return Status(Err::NOT_INITIALIZED, 0, "begin not called");
+  }
+  if (!indexValid(index)) {
+    return Status(Err::INVALID_CONFIG, index, "index out of range");
+  }
+  if (!_pack.valid()) {
+    return Status(Err::NOT_INITIALIZED, 0, "no pack attached");
+  }
   return Ok();
 }
 
+void StatusLed::stopPackModes() {
+  const uint8_t count = safeLedCount(_config.ledCount);
+  for (uint8_t i = 0; i < count; ++i) {
+    LedState& led = _leds[i];
+    if (led.tempActive &&
+        (led.resumeMode == Mode::PackPattern || led.resumeMode == Mode::PackTrack)) {
+      led.resumeMode = Mode::Off;
+    }
+    if (led.mode == Mode::PackPattern || led.mode == Mode::PackTrack) {
+      led.packRef = 0;
+      setModeInternal(i, Mode::Off, ModeParams{});
+    }
+  }
+}
+
 Status StatusLed::setModeInternal(uint8_t index, Mode mode, const ModeParams& params) {
   LedState& led = _leds[index];
   led.mode = mode;
   led.params = sanitizeParams(mode, params);
   led.phase = 0;
+  led.packStep = 0;
   led.useAlt = false;
   led.modeStartMs = _lastTickMs;
   led.nextUpdateMs = _lastTickMs;
   led.updateScheduled = true;
   led.phaseEndMs = _lastTickMs;
+  markActive(index);
+  releaseExtIfUnused(index);
+  markChanged(index);
   return Ok();
 }
 
+void StatusLed::releaseExtIfUnused(uint8_t index) {
+  LedState& led = _leds[index];
+  if (led.ext == kNoExtBlock || led.mode == Mode::Custom ||
+      (led.tempActive && led.resumeMode == Mode::Custom)) {
+    return;
+  }
+  _ext.release(led.ext);
+  led.ext = kNoExtBlock;
+}
+
 Status StatusLed::setColorInternal(uint8_t index, const RgbColor& color, bool secondary) {
   LedState& led = _leds[index];
-  if (secondary) {
-    led.altColor = color;
-  } else {
-    led.color = color;
+  RgbColor& target = secondary ? led.altColor : led.color;
+  if (target != color) {
+    target = color;
+    markChanged(index);
   }
   refreshLedOutput(index);
   return Ok();
@@ -635,6 +1342,9 @@ Status StatusLed::applyPresetInternal(uint8_t index, StatusPreset preset) {
   }
 
   LedState& led = _leds[index];
+  if (preset == StatusPreset::Critical) {
+    _frameUrgent = true;
+  }
   led.currentPreset = preset;
   led.color = def->primary;
   led.altColor = def->secondary;
@@ -661,14 +1371,11 @@ void StatusLed::refreshLedOutput(uint8_t index, uint8_t intensity, bool useAlt)
   }
   const LedState& led = _leds[index];
   const RgbColor base = useAlt ? led.altColor : led.color;
-
-  const uint8_t scaled1 = scale8(intensity, led.brightness);
-  const uint8_t scaled2 = scale8(scaled1, _config.globalBrightness);
-
-  const RgbColor out(
-      scale8(base.r, scaled2),
-      scale8(base.g, scaled2),
-      scale8(base.b, scaled2));
+  uint8_t global = _config.globalBrightness;
+  if (_idleScale != 255 && !idleExempt(led)) {
+    global = scale8(global, _idleScale);
+  }
+  const RgbColor out = scaleColor(base, intensity, led.brightness, global);
 
   if (_frame[index] != out) {
     _frame[index] = out;
@@ -687,15 +1394,19 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
       led.resumeAltColor = led.altColor;
       led.resumeBrightness = led.brightness;
       led.resumePreset = led.currentPreset;
+      led.resumePackRef = led.packRef;
     }
+    const bool wasActive = led.tempActive;
+    led.tempActive = true;  // Keeps state the resume mode owns (extension block)
     const Status applySt = applyPresetInternal(index, led.tempPreset);
     if (!applySt.ok()) {
+      led.tempActive = wasActive;
       led.tempPending = false;
       _lastStatus = applySt;
       return;
     }
-    led.tempActive = true;
     led.tempPending = false;
+    _frameUrgent = true;
     led.tempUntilMs = now_ms + led.tempDurationMs;
   }
 
@@ -707,18 +1418,25 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
     led.altColor = led.resumeAltColor;
     led.brightness = led.resumeBrightness;
     led.currentPreset = led.resumePreset;
+    led.packRef = led.resumePackRef;
+    led.packStep = 0;
     led.phase = 0;
     led.useAlt = false;
     led.modeStartMs = now_ms;
     led.nextUpdateMs = now_ms;
     led.updateScheduled = true;
     led.phaseEndMs = now_ms;
+    releaseExtIfUnused(index);
+    markChanged(index);
     refreshLedOutput(index);
   }
 
   if (!led.updateScheduled) {
     return;
   }
+  if (_config.frameClockMs > 0 && evaluateAtEdge(index, now_ms)) {
+    return;
+  }
   if (!timeReached(now_ms, led.nextUpdateMs)) {
     return;
   }
@@ -758,60 +1476,57 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
       led.nextUpdateMs = led.phaseEndMs;
       led.updateScheduled = true;
     } break;
-    case Mode::DoubleBlink: {
-      const PatternStep& step = kPatternDoubleBlink[led.phase % (sizeof(kPatternDoubleBlink) / sizeof(kPatternDoubleBlink[0]))];
-      led.intensity = step.intensity;
-      led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
-      led.nextUpdateMs = now_ms + step.durationMs;
-      led.updateScheduled = true;
-    } break;
-    case Mode::TripleBlink: {
-      const PatternStep& step = kPatternTripleBlink[led.phase % (sizeof(kPatternTripleBlink) / sizeof(kPatternTripleBlink[0]))];
-      led.intensity = step.intensity;
-      led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
-      led.nextUpdateMs = now_ms + step.durationMs;
-      led.updateScheduled = true;
-    } break;
-    case Mode::Beacon: {
-      const PatternStep& step = kPatternBeacon[led.phase % (sizeof(kPatternBeacon) / sizeof(kPatternBeacon[0]))];
-      led.intensity = step.intensity;
-      led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
-      led.nextUpdateMs = now_ms + step.durationMs;
-      led.updateScheduled = true;
-    } break;
-    case Mode::Strobe: {
-      const PatternStep& step = kPatternStrobe[led.phase % (sizeof(kPatternStrobe) / sizeof(kPatternStrobe[0]))];
+    case Mode::DoubleBlink:
+    case Mode::TripleBlink:
+    case Mode::Beacon:
+    case Mode::Strobe:
+    case Mode::Heartbeat:
+    case Mode::Alternate:
+    case Mode::SOS: {
+      size_t stepCount = 0;
+      const PatternStep* steps = patternTable(led.mode, &stepCount);
+      const PatternStep& step = steps[led.phase % stepCount];
       led.intensity = step.intensity;
       led.useAlt = step.useAlt;
       led.phase = static_cast<uint8_t>(led.phase + 1);
       led.nextUpdateMs = now_ms + step.durationMs;
       led.updateScheduled = true;
     } break;
-    case Mode::Heartbeat: {
-      const PatternStep& step = kPatternHeartbeat[led.phase % (sizeof(kPatternHeartbeat) / sizeof(kPatternHeartbeat[0]))];
+    case Mode::PackPattern: {
+      const PackPattern& pattern = _pack.pattern(led.packRef);
+      if (led.packStep >= pattern.stepCount) {
+        led.packStep = 0;
+      }
+      const PackStep& step = _pack.step(static_cast<uint32_t>(pattern.firstStep) + led.packStep);
       led.intensity = step.intensity;
-      led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
+      led.useAlt = (step.flags & kPackStepUseAlt) != 0;
+      led.packStep = static_cast<uint16_t>(led.packStep + 1);
       led.nextUpdateMs = now_ms + step.durationMs;
       led.updateScheduled = true;
     } break;
-    case Mode::Alternate: {
-      const PatternStep& step = kPatternPolice[led.phase % (sizeof(kPatternPolice) / sizeof(kPatternPolice[0]))];
+    case Mode::PackTrack:
+      led.nextUpdateMs = now_ms + updatePackTrack(led, now_ms);
+      break;
+    case Mode::Custom: {
+      CustomBlock* custom = customBlock(_ext, led.ext);
+      CustomContext ctx;
+      ctx.index = index;
+      ctx.modeStartMs = led.modeStartMs;
+      ctx.params = &led.params;
+      ctx.user = custom->user;
+      ctx.state = custom->state;
+      const CustomStep step = custom->fn(ctx, now_ms);
       led.intensity = step.intensity;
       led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
-      led.nextUpdateMs = now_ms + step.durationMs;
-      led.updateScheduled = true;
+      led.nextUpdateMs = now_ms + step.nextChangeMs;
+      led.updateScheduled = step.nextChangeMs > 0;
     } break;
-    case Mode::SOS: {
-      const PatternStep& step = kPatternSOS[led.phase % (sizeof(kPatternSOS) / sizeof(kPatternSOS[0]))];
-      led.intensity = step.intensity;
-      led.useAlt = step.useAlt;
-      led.phase = static_cast<uint8_t>(led.phase + 1);
-      led.nextUpdateMs = now_ms + step.durationMs;
+    case Mode::Spatial: {
+      uint32_t sleepMs = 0;
+      led.intensity = spatialLevel(_spatial, _spatialDelayMs[index], _spatialGain[index],
+                                   now_ms - _spatialStartMs, &sleepMs);
+      led.useAlt = false;
+      led.nextUpdateMs = now_ms + ((sleepMs > 0) ? sleepMs : _config.smoothStepMs);
       led.updateScheduled = true;
     } break;
     case Mode::FadeIn: {
@@ -844,22 +1559,7 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
     case Mode::PulseSharp:
     case Mode::Breathing:
     case Mode::Throb: {
-      const uint16_t period = (led.params.periodMs > 0) ? led.params.periodMs : 1;
-      const uint16_t phase = static_cast<uint16_t>(now_ms % period);
-      const uint16_t half = period / 2;
-      uint8_t raw = 0;
-      if (phase < half) {
-        raw = lerpU8(led.params.minLevel, led.params.maxLevel, phase, half);
-      } else {
-        raw = lerpU8(led.params.maxLevel, led.params.minLevel, static_cast<uint16_t>(phase - half), half);
-      }
-      uint8_t shaped = raw;
-      if (led.mode == Mode::PulseSoft || led.mode == Mode::Breathing || led.mode == Mode::Throb) {
-        shaped = ease8InOut(raw);
-        if (led.mode == Mode::Breathing) {
-          shaped = scale8(shaped, shaped);
-        }
-      }
+      const uint8_t shaped = pulseLevel(led.mode, led.params, now_ms);
       led.intensity = shaped;
       led.useAlt = false;
       led.nextUpdateMs = now_ms + _config.smoothStepMs;
@@ -867,19 +1567,10 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
     } break;
     case Mode::FlickerCandle:
     case Mode::Glitch: {
-      if (led.lfsr == 0) led.lfsr = 0xACE1u;
-      led.lfsr = (led.lfsr >> 1) ^ (-(static_cast<int32_t>(led.lfsr & 1u)) & 0xB400u);
-      const uint8_t rand8 = static_cast<uint8_t>(led.lfsr & 0xFFu);
-      if (led.mode == Mode::FlickerCandle) {
-        const uint8_t base = 140;
-        const uint8_t span = 100;
-        led.intensity = static_cast<uint8_t>(base + (rand8 % span));
-      } else {
-        led.intensity = (rand8 < 30) ? 0 : 255;
-      }
+      const uint8_t rand8 = lfsrNext(&led.lfsr);
+      led.intensity = flickerLevel(led.mode, rand8);
       led.useAlt = false;
-      const uint16_t jitter = static_cast<uint16_t>(30 + (rand8 % 60));
-      led.nextUpdateMs = now_ms + jitter;
+      led.nextUpdateMs = now_ms + flickerHoldMs(rand8);
       led.updateScheduled = true;
     } break;
     default:
@@ -891,6 +1582,138 @@ void StatusLed::updateLed(uint8_t index, uint32_t now_ms) {
   refreshLedOutput(index, led.intensity, led.useAlt);
 }
 
+uint32_t StatusLed::updatePackTrack(LedState& led, uint32_t now_ms) {
+  const PackTrack& track = _pack.track(led.packRef);
+  const uint32_t elapsed = now_ms - led.modeStartMs;
+  uint32_t t = elapsed;
+  if (track.flags & kPackTrackLoop) {
+    t = elapsed % track.durationMs;
+  } else if (elapsed >= track.durationMs) {
+    const PackKeyframe& last = _pack.keyframe(static_cast<uint32_t>(track.firstKey) + track.keyCount - 1);
+    led.intensity = last.intensity;
+    led.useAlt = (last.flags & kPackKeyUseAlt) != 0;
+    led.updateScheduled = false;
+    return 0;
+  }
+
+  // packStep caches the current segment; rescan only after a loop wrap.
+  uint16_t key = led.packStep;
+  if (key >= track.keyCount || _pack.keyframe(static_cast<uint32_t>(track.firstKey) + key).timeMs > t) {
+    key = 0;
+  }
+  while (key + 1u < track.keyCount &&
+         _pack.keyframe(static_cast<uint32_t>(track.firstKey) + key + 1u).timeMs <= t) {
+    ++key;
+  }
+  led.packStep = key;
+
+  const PackKeyframe& cur = _pack.keyframe(static_cast<uint32_t>(track.firstKey) + key);
+  led.useAlt = (cur.flags & kPackKeyUseAlt) != 0;
+  led.updateScheduled = true;
+  if (t < cur.timeMs) {
+    // Before the first keyframe: hold its value.
+    led.intensity = cur.intensity;
+    return cur.timeMs - t;
+  }
+  if (key + 1u >= track.keyCount) {
+    // After the last keyframe: hold until the track ends.
+    led.intensity = cur.intensity;
+    return track.durationMs - t;
+  }
+  const PackKeyframe& next = _pack.keyframe(static_cast<uint32_t>(track.firstKey) + key + 1u);
+  const uint32_t untilNext = next.timeMs - t;
+  if (cur.flags & kPackKeyHold) {
+    led.intensity = cur.intensity;
+    return untilNext;
+  }
+  led.intensity = lerpU8(cur.intensity, next.intensity, static_cast<uint16_t>(t - cur.timeMs),
+                         static_cast<uint16_t>(next.timeMs - cur.timeMs));
+  return (untilNext < _config.smoothStepMs) ? untilNext : _config.smoothStepMs;
+}
+
+bool StatusLed::evaluateAtEdge(uint8_t index, uint32_t now_ms) {
+  LedState& led = _leds[index];
+  const uint32_t elapsed = now_ms - led.modeStartMs;
+  switch (led.mode) {
+    case Mode::BlinkSlow:
+    case Mode::BlinkFast:
+      led.intensity = blinkOnAt(led.params, elapsed) ? 255 : 0;
+      led.useAlt = false;
+      break;
+    case Mode::DoubleBlink:
+    case Mode::TripleBlink:
+    case Mode::Beacon:
+    case Mode::Strobe:
+    case Mode::Heartbeat:
+    case Mode::Alternate:
+    case Mode::SOS: {
+      size_t stepCount = 0;
+      const PatternStep* steps = patternTable(led.mode, &stepCount);
+      const PatternStep& step = patternStepAt(steps, stepCount, elapsed);
+      led.intensity = step.intensity;
+      led.useAlt = step.useAlt;
+    } break;
+    case Mode::PackPattern: {
+      const PackPattern& pattern = _pack.pattern(led.packRef);
+      const uint32_t first = pattern.firstStep;
+      uint32_t cycle = 0;
+      for (uint16_t i = 0; i < pattern.stepCount; ++i) {
+        cycle += _pack.step(first + i).durationMs;
+      }
+      uint32_t t = (cycle > 0) ? elapsed % cycle : 0;
+      uint16_t i = 0;
+      for (; i + 1u < pattern.stepCount; ++i) {
+        const uint16_t durationMs = _pack.step(first + i).durationMs;
+        if (t < durationMs) {
+          break;
+        }
+        t -= durationMs;
+      }
+      const PackStep& step = _pack.step(first + i);
+      led.intensity = step.intensity;
+      led.useAlt = (step.flags & kPackStepUseAlt) != 0;
+    } break;
+    case Mode::PackTrack:
+      (void)updatePackTrack(led, now_ms);
+      break;
+    case Mode::PulseSoft:
+    case Mode::PulseSharp:
+    case Mode::Breathing:
+    case Mode::Throb:
+      led.intensity = pulseLevel(led.mode, led.params, now_ms);
+      led.useAlt = false;
+      break;
+    case Mode::Spatial: {
+      uint32_t sleepMs = 0;
+      led.intensity = spatialLevel(_spatial, _spatialDelayMs[index], _spatialGain[index],
+                                   now_ms - _spatialStartMs, &sleepMs);
+      led.useAlt = false;
+    } break;
+    case Mode::FadeIn:
+    case Mode::FadeOut: {
+      const bool in = led.mode == Mode::FadeIn;
+      const uint16_t durationMs = in ? led.params.riseMs : led.params.fallMs;
+      const uint8_t from = in ? 0 : 255;
+      led.useAlt = false;
+      if (elapsed >= durationMs) {
+        led.intensity = static_cast<uint8_t>(255 - from);
+        led.updateScheduled = false;
+      } else {
+        led.intensity = lerpU8(from, static_cast<uint8_t>(255 - from),
+                               static_cast<uint16_t>(elapsed), durationMs);
+      }
+    } break;
+    default:
+      return false;  // Static, random or user-driven: keeps its own deadline
+  }
+  refreshLedOutput(index, led.intensity, led.useAlt);
+  return true;
+}
+
+uint8_t StatusLed::activeLedCount() const {
+  return static_cast<uint8_t>(__builtin_popcount(_activeMask));
+}
+
 void StatusLed::tick(uint32_t now_ms) {
   if (!_initialized) {
     return;
@@ -903,25 +1726,253 @@ void StatusLed::tick(uint32_t now_ms) {
       _leds[i].nextUpdateMs = now_ms;
       _leds[i].phaseEndMs = now_ms;
     }
+    _nextFrameClockMs = now_ms;
+    _clockFrameDue = false;
+    _idleDeadlineMs = now_ms + _config.idleTimeoutMs;
     _timeSynced = true;
   }
 
   _lastTickMs = now_ms;
+  const uint8_t count = safeLedCount(_config.ledCount);
 
+  if (_config.frameClockMs > 0) {
+    // Frame clock: LEDs are evaluated from the clock time in one linear pass
+    // per edge; the output stage below still runs on every tick.
+    if (timeReached(now_ms, _nextFrameClockMs)) {
+      const uint32_t late = now_ms - _nextFrameClockMs;
+      _nextFrameClockMs = (late >= _config.frameClockMs)
+                              ? now_ms + _config.frameClockMs
+                              : _nextFrameClockMs + _config.frameClockMs;
+      for (uint8_t i = 0; i < count; ++i) {
+        const LedState& led = _leds[i];
+        if (led.updateScheduled || led.tempPending || led.tempActive) {
+          updateLed(i, now_ms);
+        }
+        if (!led.updateScheduled && !led.tempPending && !led.tempActive) {
+          _activeMask &= ~(1u << i);
+        }
+      }
+      _clockFrameDue = true;
+    } else {
+      // Temporary presets are urgent: apply them now rather than on the edge.
+      uint32_t pending = _activeMask;
+      while (pending != 0) {
+        const uint8_t i = static_cast<uint8_t>(__builtin_ctz(pending));
+        pending &= pending - 1;
+        if (_leds[i].tempPending) {
+          updateLed(i, now_ms);
+        }
+      }
+    }
+  } else {
+    // Visit only LEDs with pending work; static LEDs cost nothing per tick.
+    uint32_t pending = _activeMask;
+    while (pending != 0) {
+      const uint8_t i = static_cast<uint8_t>(__builtin_ctz(pending));
+      pending &= pending - 1;
+      updateLed(i, now_ms);
+      const LedState& led = _leds[i];
+      if (!led.updateScheduled && !led.tempPending && !led.tempActive) {
+        _activeMask &= ~(1u << i);
+      }
+    }
+  }
+
+  if (_idleArmed && timeReached(now_ms, _idleDeadlineMs)) {
+    stepIdle(now_ms);
+  }
+
+  if (_backend != nullptr) {
+    if (!_backend->canShow()) {
+      // A lost completion must not wedge output, even with nothing new to send:
+      // the backend enforces a deadline and the frame is sent again.
+      const Status stall = _backend->recoverStall();
+      if (!stall.ok()) {
+        if (stall.code == Err::TIMEOUT) {
+          ++_frameStats.txTimeouts;
+        }
+        _lastStatus = stall;
+        discardInFlight();
+      }
+    }
+    confirmDisplayed();
+    if (_config.powerPin >= 0 && !gatePower(now_ms)) {
+      return;
+    }
+  }
+  if (!_frameDirty) {
+    _frameUrgent = false;
+    _clockFrameDue = false;
+    return;
+  }
+  if (_backend == nullptr) {
+    return;
+  }
+
+  if (_config.frameClockMs > 0 && !_clockFrameDue && !_frameUrgent) {
+    return;  // Frame clock: changes wait for the next edge unless urgent
+  }
+  if (!_backend->canShow()) {
+    // Supersede a stale in-flight frame instead of queueing behind it.
+    if (!_frameUrgent || _inFlightUrgent || !_backend->abortShow().ok()) {
+      return;
+    }
+    ++_frameStats.framesAborted;
+    discardInFlight();
+    _inFlightUrgent = true;  // Nothing stale left in flight; do not abort again
+    if (!_backend->canShow()) {
+      return;
+    }
+  }
+
+  const Status st = _backend->show(_frame, count, _config.colorOrder);
+  if (st.ok()) {
+    _frameDirty = false;
+    _clockFrameDue = false;
+    _inFlightUrgent = _frameUrgent;
+    _frameUrgent = false;
+    ++_frameStats.framesSent;
+    _inFlight.seq = _frameStats.framesSent;
+    _inFlight.version = _stateVersion;
+    _inFlight.changeUs = _unconfirmedSinceUs;
+    _inFlight.pending = true;
+    _unconfirmed = false;
+  } else if (st.code == Err::RESOURCE_BUSY) {
+    // Keep dirty and try again next tick
+  } else {
+    ++_frameStats.showErrors;
+    _lastStatus = st;
+  }
+}
+
+void StatusLed::confirmDisplayed() {
+  if (_inFlight.pending) {
+    if (!_backend->canShow()) {
+      return;  // Still on the wire
+    }
+    _inFlight.pending = false;
+    acknowledge(_inFlight.seq, _inFlight.version, _inFlight.changeUs, _backend->lastDoneUs());
+  }
+  // Nothing queued: the LEDs already show every change made since.
+  if (_unconfirmed && !_frameDirty) {
+    _unconfirmed = false;
+    acknowledge(_frameStats.framesSent, _stateVersion, _unconfirmedSinceUs, _backend->nowUs());
+  }
+}
+
+void StatusLed::stepIdle(uint32_t now_ms) {
+  if (!_idleRamping) {
+    _idleRamping = true;
+    _idleRampStartMs = _idleDeadlineMs;  // Late ticks catch up instead of stretching the ramp
+  }
+  const uint32_t elapsed = now_ms - _idleRampStartMs;
+  uint8_t level = _config.idleLevel;
+  if (elapsed < _config.idleFadeMs) {
+    const uint32_t span = 255u - _config.idleLevel;
+    level = static_cast<uint8_t>(255u - span * elapsed / _config.idleFadeMs);
+  }
+  if (level != _idleScale) {
+    _idleScale = level;
+    refreshAllOutputs();
+  }
+  if (level == _config.idleLevel) {
+    _idleArmed = false;  // Floor reached; nothing to do until the next change
+    return;
+  }
+  _idleDeadlineMs = now_ms + _config.smoothStepMs;
+}
+
+void StatusLed::refreshAllOutputs() {
   const uint8_t count = safeLedCount(_config.ledCount);
   for (uint8_t i = 0; i < count; ++i) {
-    updateLed(i, now_ms);
+    refreshLedOutput(i);
+  }
+}
+
+bool StatusLed::gatePower(uint32_t now_ms) {
+  bool black = true;
+  const uint8_t count = safeLedCount(_config.ledCount);
+  for (uint8_t i = 0; i < count && black; ++i) {
+    black = _frame[i] == kColorOff;
   }
 
-  if (_frameDirty && _backend && _backend->canShow()) {
-    const Status st = _backend->show(_frame, count, _config.colorOrder);
-    if (st.ok()) {
+  if (!_powered) {
+    if (!_frameDirty) {
+      return false;
+    }
+    if (black) {
+      // Unpowered LEDs are already dark; confirm without sending.
       _frameDirty = false;
-    } else if (st.code == Err::RESOURCE_BUSY) {
-      // Keep dirty and try again next tick
-    } else {
+      _frameUrgent = false;
+      confirmDisplayed();
+      return false;
+    }
+    const Status st = _backend->setPower(true);
+    if (!st.ok()) {
       _lastStatus = st;
+      return false;  // Retried next tick
+    }
+    _powered = true;
+    _powerSettling = true;
+    _powerReadyMs = now_ms + _config.powerSettleMs;
+  }
+  if (_powerSettling) {
+    if (!timeReached(now_ms, _powerReadyMs)) {
+      return false;
     }
+    _powerSettling = false;
+  }
+
+  // Cut only once the black frame is on the LEDs and nothing is scheduled.
+  // Idle blanking holds non-exempt LEDs black whatever they animate.
+  uint32_t live = _activeMask;
+  if (_idleScale == 0) {
+    for (uint8_t i = 0; i < count; ++i) {
+      if (!idleExempt(_leds[i])) {
+        live &= ~(1u << i);
+      }
+    }
+  }
+  if (!black || _frameDirty || live != 0 || _inFlight.pending || !_backend->canShow()) {
+    return true;
+  }
+  const Status st = _backend->setPower(false);
+  if (!st.ok()) {
+    _lastStatus = st;
+    return true;
+  }
+  _powered = false;
+  ++_frameStats.powerCuts;
+  return false;
+}
+
+void StatusLed::discardInFlight() {
+  if (!_inFlight.pending) {
+    return;
+  }
+  _inFlight.pending = false;
+  // Unconfirmed changes it carried fall back to the next frame, keeping their original time.
+  if (static_cast<int32_t>(_inFlight.version - _displayedVersion) > 0) {
+    _unconfirmed = true;
+    _unconfirmedSinceUs = _inFlight.changeUs;
+  }
+  // The frame may not have latched; send it again.
+  _frameDirty = true;
+}
+
+void StatusLed::acknowledge(uint32_t seq, uint32_t version, uint32_t changeUs,
+                            uint32_t displayedUs) {
+  if (static_cast<int32_t>(version - _displayedVersion) <= 0) {
+    return;  // Wrap-safe, as in getChangesSince()
+  }
+  _displayedVersion = version;
+  _lastAck.frameSeq = seq;
+  _lastAck.version = version;
+  _lastAck.changeUs = changeUs;
+  _lastAck.displayedUs = displayedUs;
+  _lastAck.latencyUs = displayedUs - changeUs;
+  if (_ackCallback != nullptr) {
+    _ackCallback(_lastAck, _ackUser);
   }
 }
 
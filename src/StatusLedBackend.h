@@ -15,6 +15,40 @@ struct BackendBase {
   virtual void end() = 0;
   virtual bool canShow() const = 0;
   virtual Status show(const RgbColor* frame, uint8_t count, ColorOrder order) = 0;
+
+  /// @brief Abort the in-flight frame so a newer frame can replace it.
+  /// @return Ok once aborted (canShow() turns true after the latch gap),
+  ///         or UNSUPPORTED if the driver cannot abort a transfer.
+  virtual Status abortShow() { return Status(Err::UNSUPPORTED, 0, "abort not supported"); }
+
+  /// @brief Recover from a transmit whose completion is overdue.
+  /// @return Ok if nothing is overdue, TIMEOUT if an overdue transmit was
+  ///         recovered (canShow() may turn true; counted in
+  ///         FrameStats::txTimeouts), or another error if recovery failed
+  ///         (retried on the next call) or the driver was rebuilt for
+  ///         another reason.
+  virtual Status recoverStall() { return Ok(); }
+
+  /// @brief Switch the LED supply rail (Config::powerPin; no-op without one).
+  virtual Status setPower(bool on) {
+    (void)on;
+    return Ok();
+  }
+
+  /// @brief Install (or clear, with nullptr) the frame completion callback.
+  /// @return Ok, or UNSUPPORTED if the driver has no completion interrupt.
+  virtual Status setDoneCallback(FrameDoneCallback callback, void* user) {
+    (void)callback;
+    (void)user;
+    return Status(Err::UNSUPPORTED, 0, "done callback not supported");
+  }
+
+  /// @brief Microsecond clock for display acknowledgements (0 if unavailable).
+  virtual uint32_t nowUs() const { return 0; }
+
+  /// @brief Time the last completed frame latched. Defaults to now, i.e. when
+  ///        completion was observed, for drivers without a completion timestamp.
+  virtual uint32_t lastDoneUs() const { return nowUs(); }
 };
 
 BackendBase* createBackend();
@@ -13,6 +13,7 @@
 extern "C" {
 #include "driver/gpio.h"
 #include "driver/rmt.h"
+#include "esp_timer.h"
 }
 
 namespace StatusLed {
@@ -26,35 +27,47 @@ class BackendIdfWs2812 final : public BackendBase {
     if (config.dataPin < 0) {
       return Status(Err::INVALID_CONFIG, config.dataPin, "dataPin must be >= 0");
     }
+    if (chainCount(config) > 1) {
+      return Status(Err::UNSUPPORTED, chainCount(config), "chainPins need the IDF5 backend");
+    }
 
+    if (config.rmtChannel >= RMT_CHANNEL_MAX) {
+      return Status(Err::INVALID_CONFIG, config.rmtChannel, "rmtChannel out of range");
+    }
     _channel = static_cast<rmt_channel_t>(config.rmtChannel);
-    const gpio_num_t gpio = static_cast<gpio_num_t>(config.dataPin);
-    if (!GPIO_IS_VALID_OUTPUT_GPIO(gpio)) {
+    _gpio = static_cast<gpio_num_t>(config.dataPin);
+    if (!GPIO_IS_VALID_OUTPUT_GPIO(_gpio)) {
       return Status(Err::INVALID_CONFIG, config.dataPin, "dataPin is not a valid output GPIO");
     }
 
-    rmt_config_t rmt_cfg = RMT_DEFAULT_CONFIG_TX(gpio, _channel);
-    rmt_cfg.clk_div = kRmtClkDiv;
-    rmt_cfg.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
-    rmt_cfg.tx_config.idle_output_en = true;
-    rmt_cfg.tx_config.carrier_en = false;
-
-    esp_err_t err = rmt_config(&rmt_cfg);
-    if (err != ESP_OK) {
-      return Status(Err::HARDWARE_FAULT, err, "rmt_config failed");
+    const Status powerSt = beginPower(config);
+    if (!powerSt.ok()) {
+      return powerSt;
     }
 
-    err = rmt_driver_install(_channel, 0, 0);
-    if (err != ESP_OK) {
-      return Status(Err::HARDWARE_FAULT, err, "rmt_driver_install failed");
+    const Status st = install();
+    if (!st.ok()) {
+      return st;
     }
 
-    _installed = true;
+    // The legacy driver has one tx-end callback for all channels. Every
+    // instance shares a single registration that dispatches by channel and
+    // chains to whoever registered before the first one.
+    if (!s_txEndRegistered) {
+      s_prevTxEnd = rmt_register_tx_end_callback(&BackendIdfWs2812::onTxEnd, nullptr);
+      s_txEndRegistered = true;
+    }
     _count = config.ledCount;
     return Ok();
   }
 
   void end() override {
+    if (s_byChannel[_channel] == this) {
+      s_byChannel[_channel] = nullptr;
+    }
+    if (_count > 0) {
+      releaseTxEnd();  // Also after a failed rebuild left the channel uninstalled
+    }
     if (_installed) {
       // Best-effort: blank LEDs before releasing the driver
       if (_count > 0 && rmt_wait_tx_done(_channel, 10) == ESP_OK) {
@@ -66,17 +79,36 @@ class BackendIdfWs2812 final : public BackendBase {
       }
       rmt_driver_uninstall(_channel);
       _installed = false;
-      _count = 0;
     }
+    _txBusy = false;
+    _count = 0;
+    _powerPin = GPIO_NUM_NC;  // Rail left as is
   }
 
-  bool canShow() const override {
-    if (!_installed) {
-      return false;
+  Status setPower(bool on) override {
+    if (_powerPin == GPIO_NUM_NC) {
+      return Ok();
+    }
+    const esp_err_t err = gpio_set_level(_powerPin, on == _powerActiveHigh ? 1u : 0u);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "gpio_set_level failed");
     }
-    return rmt_wait_tx_done(_channel, 0) != ESP_ERR_TIMEOUT;
+    return Ok();
+  }
+
+  Status setDoneCallback(FrameDoneCallback callback, void* user) override {
+    _doneCallback = nullptr;  // The ISR never sees a callback with the wrong user
+    _doneUser = user;
+    _doneCallback = callback;
+    return Ok();
   }
 
+  uint32_t nowUs() const override { return static_cast<uint32_t>(esp_timer_get_time()); }
+
+  uint32_t lastDoneUs() const override { return static_cast<uint32_t>(_txDoneUs); }
+
+  bool canShow() const override { return _installed && !_txBusy; }
+
   Status show(const RgbColor* frame, uint8_t count, ColorOrder order) override {
     if (!_installed) {
       return Status(Err::NOT_INITIALIZED, 0, "Backend not initialized");
@@ -88,37 +120,155 @@ class BackendIdfWs2812 final : public BackendBase {
       return Status(Err::INVALID_CONFIG, count, "count out of range");
     }
 
-    const esp_err_t waitErr = rmt_wait_tx_done(_channel, 0);
-    if (waitErr == ESP_ERR_TIMEOUT) {
+    if (_txBusy) {
       return Status(Err::RESOURCE_BUSY, 0, "rmt busy");
     }
-    if (waitErr != ESP_OK) {
-      return Status(Err::HARDWARE_FAULT, waitErr, "rmt_wait_tx_done failed");
-    }
 
     const size_t itemCount = buildItems(frame, count, order);
     if (itemCount == 0) {
       return Status(Err::INTERNAL_ERROR, 0, "item build failed");
     }
 
+    _txBusy = true;  // Before the write: the tx-end interrupt may fire before it returns
     const esp_err_t err = rmt_write_items(_channel, _items, static_cast<int>(itemCount), false);
     if (err != ESP_OK) {
+      _txBusy = false;
       return Status(Err::HARDWARE_FAULT, err, "rmt_write_items failed");
     }
+    _txDeadlineUs = esp_timer_get_time() + static_cast<int64_t>(count) * kWireUsPerLed + kLatchUs +
+                    kTxTimeoutMarginUs;
     return Ok();
   }
 
+  Status recoverStall() override {
+    if (_count == 0) {
+      return Ok();  // Not begun
+    }
+    if (!_installed) {
+      return reinstall();  // An earlier rebuild failed
+    }
+    if (!_txBusy || esp_timer_get_time() < _txDeadlineUs) {
+      return Ok();
+    }
+    // Channel idle: the frame went out but our callback did not run (another
+    // component replaced the driver's tx-end callback without chaining).
+    if (rmt_wait_tx_done(_channel, 0) == ESP_OK) {
+      _txBusy = false;
+      return Status(Err::TIMEOUT, 0, "rmt tx end callback lost");
+    }
+    // Channel stuck or its tx-end interrupt lost: the driver's tx semaphore is
+    // only released by that interrupt, and rmt_tx_stop() leaves it taken, so
+    // the next rmt_write_items() would block forever. Rebuild the channel.
+    s_byChannel[_channel] = nullptr;
+    (void)rmt_driver_uninstall(_channel);
+    _installed = false;
+    return reinstall();
+  }
+
  private:
+  static void onTxEnd(rmt_channel_t channel, void*) {
+    BackendIdfWs2812* self =
+        (channel >= RMT_CHANNEL_0 && channel < RMT_CHANNEL_MAX) ? s_byChannel[channel] : nullptr;
+    if (self != nullptr && self->_txBusy) {
+      self->_txDoneUs = esp_timer_get_time() + kLatchUs;
+      self->_txBusy = false;
+      const FrameDoneCallback callback = self->_doneCallback;
+      if (callback != nullptr) {
+        (void)callback(self->_doneUser);  // No yield hook in the legacy ISR
+      }
+    }
+    const rmt_tx_end_callback_t prev = s_prevTxEnd;
+    if (prev.function != nullptr) {
+      prev.function(channel, prev.arg);
+    }
+  }
+
+  /// Drop the shared registration once the last instance is gone. If another
+  /// component registered on top of us, keep it installed; onTxEnd then only
+  /// forwards to the callback we displaced.
+  static void releaseTxEnd() {
+    if (!s_txEndRegistered) {
+      return;
+    }
+    for (BackendIdfWs2812* instance : s_byChannel) {
+      if (instance != nullptr) {
+        return;
+      }
+    }
+    const rmt_tx_end_callback_t current =
+        rmt_register_tx_end_callback(s_prevTxEnd.function, s_prevTxEnd.arg);
+    if (current.function != &BackendIdfWs2812::onTxEnd) {
+      rmt_register_tx_end_callback(current.function, current.arg);
+      return;
+    }
+    s_prevTxEnd = rmt_tx_end_callback_t{};
+    s_txEndRegistered = false;
+  }
+
   static constexpr uint8_t kRmtClkDiv = 2;          // 80MHz / 2 = 40MHz
   static constexpr uint16_t kT0H = 16;              // 0.4us
   static constexpr uint16_t kT0L = 34;              // 0.85us
   static constexpr uint16_t kT1H = 32;              // 0.8us
   static constexpr uint16_t kT1L = 18;              // 0.45us
   static constexpr uint16_t kResetTicks = 3200;     // 80us
+  static constexpr int64_t kLatchUs = 80;           // kResetTicks
+  static constexpr int64_t kWireUsPerLed = 30;      // 24 bits at 800kHz
+  // Completion may legitimately lag behind the wire (ISRs deferred during flash writes).
+  static constexpr int64_t kTxTimeoutMarginUs = 20000;
   static constexpr uint8_t kMaxLeds = ::StatusLed::StatusLed::kMaxLedCount;
   static constexpr uint16_t kBitsPerLed = 24;
   static constexpr uint16_t kMaxItems = (kMaxLeds * kBitsPerLed) + 1;
 
+  // Configure and install the RMT channel, and route its tx-end interrupts here.
+  Status install() {
+    rmt_config_t rmt_cfg = RMT_DEFAULT_CONFIG_TX(_gpio, _channel);
+    rmt_cfg.clk_div = kRmtClkDiv;
+    rmt_cfg.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    rmt_cfg.tx_config.idle_output_en = true;
+    rmt_cfg.tx_config.carrier_en = false;
+
+    esp_err_t err = rmt_config(&rmt_cfg);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "rmt_config failed");
+    }
+
+    err = rmt_driver_install(_channel, 0, 0);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "rmt_driver_install failed");
+    }
+    _txBusy = false;
+    _installed = true;
+    s_byChannel[_channel] = this;
+    return Ok();
+  }
+
+  Status reinstall() {
+    const Status st = install();
+    if (!st.ok()) {
+      return st;  // Still not installed; retried on the next recoverStall()
+    }
+    return Status(Err::TIMEOUT, 1, "rmt stalled, channel reinstalled");
+  }
+
+  // Configure Config::powerPin as an output and switch the rail on.
+  Status beginPower(const Config& config) {
+    if (config.powerPin < 0) {
+      return Ok();
+    }
+    const gpio_num_t pin = static_cast<gpio_num_t>(config.powerPin);
+    if (!GPIO_IS_VALID_OUTPUT_GPIO(pin)) {
+      return Status(Err::INVALID_CONFIG, config.powerPin, "powerPin is not a valid output GPIO");
+    }
+    gpio_reset_pin(pin);
+    const esp_err_t err = gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "powerPin setup failed");
+    }
+    _powerPin = pin;
+    _powerActiveHigh = config.powerActiveHigh;
+    return setPower(true);
+  }
+
   size_t buildItems(const RgbColor* frame, uint8_t count, ColorOrder order) {
     if (frame == nullptr || count == 0 || count > kMaxLeds) {
       return 0;
@@ -162,10 +312,26 @@ class BackendIdfWs2812 final : public BackendBase {
 
   rmt_item32_t _items[kMaxItems]{};
   rmt_channel_t _channel = RMT_CHANNEL_0;
+  gpio_num_t _gpio = GPIO_NUM_NC;
   bool _installed = false;
   uint8_t _count = 0;
+  gpio_num_t _powerPin = GPIO_NUM_NC;
+  bool _powerActiveHigh = true;
+  int64_t _txDeadlineUs = 0;
+  volatile bool _txBusy = false;
+  volatile int64_t _txDoneUs = 0;  ///< Set by onTxEnd (ISR)
+  FrameDoneCallback volatile _doneCallback = nullptr;  ///< Read by onTxEnd (ISR)
+  void* volatile _doneUser = nullptr;
+
+  static BackendIdfWs2812* volatile s_byChannel[RMT_CHANNEL_MAX];  ///< Read by onTxEnd (ISR)
+  static rmt_tx_end_callback_t s_prevTxEnd;
+  static bool s_txEndRegistered;
 };
 
+BackendIdfWs2812* volatile BackendIdfWs2812::s_byChannel[RMT_CHANNEL_MAX] = {};
+rmt_tx_end_callback_t BackendIdfWs2812::s_prevTxEnd{};
+bool BackendIdfWs2812::s_txEndRegistered = false;
+
 }  // namespace
 
 BackendBase* createBackend() {
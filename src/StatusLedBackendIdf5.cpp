@@ -15,8 +15,32 @@ extern "C" {
 #include "driver/gpio.h"
 #include "driver/rmt_encoder.h"
 #include "driver/rmt_tx.h"
+#include "esp_timer.h"
+#include "soc/soc_caps.h"
 }
 
+// Hardware-looped uniform frames need the TX loop counter and a loop that
+// stops by itself after the last round (no ISR-timed stop overshooting).
+#if SOC_RMT_SUPPORT_TX_LOOP_COUNT && SOC_RMT_SUPPORT_TX_LOOP_AUTO_STOP
+#define STATUSLED_IDF5_TX_LOOP 1
+#else
+#define STATUSLED_IDF5_TX_LOOP 0
+#endif
+
+// Chains on several data pins start together through an RMT sync manager.
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+#define STATUSLED_IDF5_TX_SYNC 1
+#else
+#define STATUSLED_IDF5_TX_SYNC 0
+#endif
+
+// One memory block per channel, so every TX channel of the chip stays usable.
+#ifdef SOC_RMT_MEM_WORDS_PER_CHANNEL
+#define STATUSLED_IDF5_CHAIN_MEM_SYMBOLS SOC_RMT_MEM_WORDS_PER_CHANNEL
+#else
+#define STATUSLED_IDF5_CHAIN_MEM_SYMBOLS 48
+#endif
+
 namespace StatusLed {
 namespace {
 
@@ -42,37 +66,243 @@ class BackendIdf5Ws2812 final : public BackendBase {
       return Status(Err::INVALID_CONFIG, config.ledCount, "ledCount out of range");
     }
 
-    const gpio_num_t gpio = static_cast<gpio_num_t>(config.dataPin);
-    if (!GPIO_IS_VALID_OUTPUT_GPIO(gpio)) {
-      return Status(Err::INVALID_CONFIG, config.dataPin, "dataPin is not a valid output GPIO");
+    const uint8_t chains = chainCount(config);
+    if (chains > 1 && !STATUSLED_IDF5_TX_SYNC) {
+      return Status(Err::UNSUPPORTED, chains, "rmt sync manager not available on this chip");
+    }
+    for (uint8_t c = 0; c < chains; ++c) {
+      const int pin = (c == 0) ? config.dataPin : config.chainPins[c - 1];
+      _gpios[c] = static_cast<gpio_num_t>(pin);
+      if (!GPIO_IS_VALID_OUTPUT_GPIO(_gpios[c])) {
+        return Status(Err::INVALID_CONFIG, pin, "dataPin is not a valid output GPIO");
+      }
+    }
+
+    const Status powerSt = beginPower(config);
+    if (!powerSt.ok()) {
+      return powerSt;
     }
 
     // Channel allocation is dynamic in IDF 5.x. Config.rmtChannel is ignored by this backend.
     (void)config.rmtChannel;
 
+    _chains = chains;
+    _chainLength = (chains > 1) ? config.chainLength : config.ledCount;
+    const Status st = install();
+    if (!st.ok()) {
+      _chains = 0;
+      return st;
+    }
+    _count = config.ledCount;
+    return Ok();
+  }
+
+  void end() override {
+    if (_installed && _count > 0 && waitAllDone(kCleanupWaitMs)) {
+      RgbColor blank[kMaxLeds]{};
+      if (transmitAll(blank, _count, ColorOrder::GRB) == ESP_OK) {
+        (void)waitAllDone(kCleanupWaitMs);
+      }
+    }
+
+    uninstall();
+    _stallRebuild = false;
+    _count = 0;
+    _chains = 0;
+    _powerPin = GPIO_NUM_NC;  // Rail left as is
+  }
+
+  Status setPower(bool on) override {
+    if (_powerPin == GPIO_NUM_NC) {
+      return Ok();
+    }
+    const esp_err_t err = gpio_set_level(_powerPin, on == _powerActiveHigh ? 1u : 0u);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "gpio_set_level failed");
+    }
+    return Ok();
+  }
+
+  bool canShow() const override {
+    if (!_installed) {
+      return false;
+    }
+    return _txBusy == 0 && !holdoffActive();
+  }
+
+  Status abortShow() override {
+    if (!_installed) {
+      return Status(Err::NOT_INITIALIZED, 0, "Backend not initialized");
+    }
+    if (_txBusy == 0) {
+      return Ok();
+    }
+    const Status st = resetChannels();
+    if (!st.ok()) {
+      return st;
+    }
+    _txBusy = 0;
+    // Keep the line low for a full reset so the partial frame is discarded, not extended.
+    _holdoffUntilUs = esp_timer_get_time() + kLatchUs;
+    _holdoff = true;
+    return Ok();
+  }
+
+  Status show(const RgbColor* frame, uint8_t count, ColorOrder order) override {
+    if (!_installed) {
+      return Status(Err::NOT_INITIALIZED, 0, "Backend not initialized");
+    }
+    if (frame == nullptr) {
+      return Status(Err::INVALID_CONFIG, 0, "frame must not be null");
+    }
+    if (count == 0 || count > kMaxLeds) {
+      return Status(Err::INVALID_CONFIG, count, "count out of range");
+    }
+    if (count > _count) {
+      return Status(Err::INVALID_CONFIG, count, "count exceeds configured ledCount");
+    }
+    if (_chains > 1 && count != _count) {
+      return Status(Err::INVALID_CONFIG, count, "chains need a full frame");  // Idle chains never start the group
+    }
+    if (!isValidColorOrder(order)) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(order), "invalid colorOrder");
+    }
+    if (_txBusy != 0 || holdoffActive()) {
+      return Status(Err::RESOURCE_BUSY, 0, "rmt busy");
+    }
+
+    _txBusy = static_cast<uint8_t>((1u << _chains) - 1u);
+    const esp_err_t err = transmitAll(frame, count, order);
+    if (err == ESP_ERR_INVALID_STATE || err == ESP_ERR_TIMEOUT) {
+      _txBusy = 0;
+      return Status(Err::RESOURCE_BUSY, err, "rmt busy");
+    }
+    if (err != ESP_OK) {
+      _txBusy = 0;
+      return Status(Err::HARDWARE_FAULT, err, "rmt_transmit failed");
+    }
+    const uint8_t longest = (count < _chainLength) ? count : _chainLength;
+    _txDeadlineUs = esp_timer_get_time() + static_cast<int64_t>(longest) * kWireUsPerLed +
+                    kLatchUs + kTxTimeoutMarginUs;
+
+    return Ok();
+  }
+
+  Status setDoneCallback(FrameDoneCallback callback, void* user) override {
+    _doneCallback = nullptr;  // The ISR never sees a callback with the wrong user
+    _doneUser = user;
+    _doneCallback = callback;
+    return Ok();
+  }
+
+  uint32_t nowUs() const override { return static_cast<uint32_t>(esp_timer_get_time()); }
+
+  uint32_t lastDoneUs() const override { return static_cast<uint32_t>(_txDoneUs + kLatchUs); }
+
+  Status recoverStall() override {
+    if (_count == 0) {
+      return Ok();  // Not begun
+    }
+    if (!_installed) {
+      return reinstall();  // An earlier rebuild or group reset failed
+    }
+    if (_txBusy == 0 || esp_timer_get_time() < _txDeadlineUs) {
+      return Ok();
+    }
+    // Channels idle: the frame went out and only done callbacks were lost.
+    if (waitAllDone(0)) {
+      _txBusy = 0;
+      return Status(Err::TIMEOUT, 0, "rmt done callback lost");
+    }
+    // Channel stuck: disabling drops the transaction, as in abortShow().
+    if (resetChannels().ok()) {
+      _txBusy = 0;
+      _holdoffUntilUs = esp_timer_get_time() + kLatchUs;
+      _holdoff = true;
+      return Status(Err::TIMEOUT, 1, "rmt stalled, channel reset");
+    }
+    // Driver state is unusable: rebuild the channels from scratch.
+    uninstall();
+    _stallRebuild = true;
+    return reinstall();
+  }
+
+ private:
+  // Configure Config::powerPin as an output and switch the rail on.
+  Status beginPower(const Config& config) {
+    if (config.powerPin < 0) {
+      return Ok();
+    }
+    const gpio_num_t pin = static_cast<gpio_num_t>(config.powerPin);
+    if (!GPIO_IS_VALID_OUTPUT_GPIO(pin)) {
+      return Status(Err::INVALID_CONFIG, config.powerPin, "powerPin is not a valid output GPIO");
+    }
+    gpio_reset_pin(pin);
+    const esp_err_t err = gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    if (err != ESP_OK) {
+      return Status(Err::HARDWARE_FAULT, err, "powerPin setup failed");
+    }
+    _powerPin = pin;
+    _powerActiveHigh = config.powerActiveHigh;
+    return setPower(true);
+  }
+
+  // Create, wire up and enable a channel and encoder per chain, then group
+  // them under a sync manager. Partial setup is undone on failure.
+  Status install() {
+    for (uint8_t c = 0; c < _chains; ++c) {
+      const Status st = installChannel(c);
+      if (!st.ok()) {
+        uninstall();
+        return st;
+      }
+    }
+
+#if STATUSLED_IDF5_TX_SYNC
+    if (_chains > 1) {
+      // The manager holds each channel's transaction until every chain has one queued.
+      rmt_sync_manager_config_t syncCfg{};
+      syncCfg.tx_channel_array = _chans;
+      syncCfg.array_size = _chains;
+      const esp_err_t err = rmt_new_sync_manager(&syncCfg, &_sync);
+      if (err != ESP_OK) {
+        _sync = nullptr;
+        uninstall();
+        return Status(Err::HARDWARE_FAULT, err, "rmt_new_sync_manager failed");
+      }
+    }
+#endif
+
+    _txBusy = 0;
+    _holdoff = false;
+    _installed = true;
+    return Ok();
+  }
+
+  Status installChannel(uint8_t c) {
     rmt_tx_channel_config_t txCfg{};
     txCfg.clk_src = RMT_CLK_SRC_DEFAULT;
-    txCfg.gpio_num = gpio;
-    txCfg.mem_block_symbols = kMemBlockSymbols;
+    txCfg.gpio_num = _gpios[c];
+    txCfg.mem_block_symbols = (_chains > 1) ? kChainMemBlockSymbols : kMemBlockSymbols;
     txCfg.resolution_hz = kRmtResolutionHz;
     txCfg.trans_queue_depth = 1;
     txCfg.flags.invert_out = false;
     txCfg.flags.with_dma = false;
 
-    esp_err_t err = rmt_new_tx_channel(&txCfg, &_tx_chan);
+    esp_err_t err = rmt_new_tx_channel(&txCfg, &_chans[c]);
     if (err != ESP_OK) {
+      _chans[c] = nullptr;
       return Status(Err::HARDWARE_FAULT, err, "rmt_new_tx_channel failed");
     }
 
     rmt_tx_event_callbacks_t txCallbacks{};
     txCallbacks.on_trans_done = &BackendIdf5Ws2812::onTxDone;
-    err = rmt_tx_register_event_callbacks(_tx_chan, &txCallbacks, this);
+    err = rmt_tx_register_event_callbacks(_chans[c], &txCallbacks, this);
     if (err != ESP_OK) {
-      (void)rmt_del_channel(_tx_chan);
-      _tx_chan = nullptr;
       return Status(Err::HARDWARE_FAULT, err, "rmt_tx_register_event_callbacks failed");
     }
 
+    // Encoders keep per-transaction state: one per channel.
     rmt_bytes_encoder_config_t bytesCfg{};
     bytesCfg.bit0.duration0 = kT0H;
     bytesCfg.bit0.level0 = 1;
@@ -84,124 +314,176 @@ class BackendIdf5Ws2812 final : public BackendBase {
     bytesCfg.bit1.level1 = 0;
     bytesCfg.flags.msb_first = true;
 
-    err = rmt_new_bytes_encoder(&bytesCfg, &_bytes_encoder);
+    err = rmt_new_bytes_encoder(&bytesCfg, &_encoders[c]);
     if (err != ESP_OK) {
-      (void)rmt_del_channel(_tx_chan);
-      _tx_chan = nullptr;
+      _encoders[c] = nullptr;
       return Status(Err::HARDWARE_FAULT, err, "rmt_new_bytes_encoder failed");
     }
 
-    err = rmt_enable(_tx_chan);
+    err = rmt_enable(_chans[c]);
     if (err != ESP_OK) {
-      (void)rmt_del_encoder(_bytes_encoder);
-      (void)rmt_del_channel(_tx_chan);
-      _bytes_encoder = nullptr;
-      _tx_chan = nullptr;
       return Status(Err::HARDWARE_FAULT, err, "rmt_enable failed");
     }
-
-    _count = config.ledCount;
-    _txBusy = false;
-    _installed = true;
     return Ok();
   }
 
-  void end() override {
-    if (_installed && _tx_chan != nullptr && _bytes_encoder != nullptr && _count > 0) {
-      if (rmt_tx_wait_all_done(_tx_chan, kCleanupWaitMs) == ESP_OK) {
-        uint8_t blank[kMaxPayloadBytes]{};
-        rmt_transmit_config_t txConfig{};
-        txConfig.loop_count = 0;
-        txConfig.flags.eot_level = 0;
-        const size_t payloadSize = static_cast<size_t>(_count) * kBytesPerLed;
-        const esp_err_t txErr =
-            rmt_transmit(_tx_chan, _bytes_encoder, blank, payloadSize, &txConfig);
-        if (txErr == ESP_OK) {
-          (void)rmt_tx_wait_all_done(_tx_chan, kCleanupWaitMs);
-        }
-      }
+  Status reinstall() {
+    const Status st = install();
+    if (!st.ok()) {
+      return st;  // Still not installed; retried on the next recoverStall()
     }
-
-    if (_tx_chan != nullptr) {
-      (void)rmt_disable(_tx_chan);
+    if (_stallRebuild) {
+      _stallRebuild = false;
+      return Status(Err::TIMEOUT, 2, "rmt stalled, channel reinstalled");
     }
-    if (_bytes_encoder != nullptr) {
-      (void)rmt_del_encoder(_bytes_encoder);
-      _bytes_encoder = nullptr;
+    // Torn down after a transmit error, not a stall: report it as a driver error.
+    return Status(Err::EXTERNAL_LIB_ERROR, 2, "rmt channel reinstalled");
+  }
+
+  // Release the sync manager, channels and encoders without touching the LEDs.
+  void uninstall() {
+#if STATUSLED_IDF5_TX_SYNC
+    if (_sync != nullptr) {
+      (void)rmt_del_sync_manager(_sync);
+      _sync = nullptr;
     }
-    if (_tx_chan != nullptr) {
-      (void)rmt_del_channel(_tx_chan);
-      _tx_chan = nullptr;
+#endif
+    for (uint8_t c = 0; c < kMaxChains; ++c) {
+      if (_chans[c] != nullptr) {
+        (void)rmt_disable(_chans[c]);
+      }
+      if (_encoders[c] != nullptr) {
+        (void)rmt_del_encoder(_encoders[c]);
+        _encoders[c] = nullptr;
+      }
+      if (_chans[c] != nullptr) {
+        (void)rmt_del_channel(_chans[c]);
+        _chans[c] = nullptr;
+      }
     }
 
     _installed = false;
-    _count = 0;
-    _txBusy = false;
-  }
-
-  bool canShow() const override {
-    if (!_installed || _tx_chan == nullptr) {
-      return false;
-    }
-    return !_txBusy;
+    _txBusy = 0;
+    _holdoff = false;
   }
 
-  Status show(const RgbColor* frame, uint8_t count, ColorOrder order) override {
-    if (!_installed || _tx_chan == nullptr || _bytes_encoder == nullptr) {
-      return Status(Err::NOT_INITIALIZED, 0, "Backend not initialized");
-    }
-    if (frame == nullptr) {
-      return Status(Err::INVALID_CONFIG, 0, "frame must not be null");
-    }
-    if (count == 0 || count > kMaxLeds) {
-      return Status(Err::INVALID_CONFIG, count, "count out of range");
+  // Drop queued or running transactions on every chain (disable + enable) and
+  // rearm the sync manager, which may hold a partially queued group.
+  Status resetChannels() {
+    for (uint8_t c = 0; c < _chains; ++c) {
+      const esp_err_t err = rmt_disable(_chans[c]);
+      if (err != ESP_OK) {
+        return Status(Err::HARDWARE_FAULT, err, "rmt_disable failed");
+      }
     }
-    if (count > _count) {
-      return Status(Err::INVALID_CONFIG, count, "count exceeds configured ledCount");
+    for (uint8_t c = 0; c < _chains; ++c) {
+      const esp_err_t err = rmt_enable(_chans[c]);
+      if (err != ESP_OK) {
+        return Status(Err::HARDWARE_FAULT, err, "rmt_enable failed");
+      }
     }
-    if (!isValidColorOrder(order)) {
-      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(order), "invalid colorOrder");
+#if STATUSLED_IDF5_TX_SYNC
+    if (_sync != nullptr) {
+      const esp_err_t err = rmt_sync_reset(_sync);
+      if (err != ESP_OK) {
+        return Status(Err::HARDWARE_FAULT, err, "rmt_sync_reset failed");
+      }
     }
-    if (_txBusy) {
-      return Status(Err::RESOURCE_BUSY, 0, "rmt busy");
+#endif
+    return Ok();
+  }
+
+  bool waitAllDone(int timeoutMs) {
+    for (uint8_t c = 0; c < _chains; ++c) {
+      if (rmt_tx_wait_all_done(_chans[c], timeoutMs) != ESP_OK) {
+        return false;
+      }
     }
+    return true;
+  }
 
-    uint8_t payload[kMaxPayloadBytes]{};
-    size_t offset = 0;
-    for (uint8_t i = 0; i < count; ++i) {
-      const RgbColor mapped = mapColorOrder(frame[i], ColorOrder::RGB, order);
-      payload[offset++] = mapped.r;
-      payload[offset++] = mapped.g;
-      payload[offset++] = mapped.b;
+  static bool isUniform(const RgbColor* frame, uint8_t count) {
+    for (uint8_t i = 1; i < count; ++i) {
+      if (frame[i] != frame[0]) {
+        return false;
+      }
     }
+    return true;
+  }
 
+  // Encode every chain's bytes first, then queue one transaction per chain;
+  // with a sync manager the last one starts the whole group. Uniform
+  // single-chain frames send one pixel and let the RMT repeat it `count`
+  // times, skipping per-pixel encoding and memory refills.
+  esp_err_t transmitAll(const RgbColor* frame, uint8_t count, ColorOrder order) {
     rmt_transmit_config_t txConfig{};
     txConfig.loop_count = 0;
     txConfig.flags.eot_level = 0;
-    const size_t payloadSize = static_cast<size_t>(count) * kBytesPerLed;
-    _txBusy = true;
-    const esp_err_t err = rmt_transmit(_tx_chan, _bytes_encoder, payload, payloadSize, &txConfig);
-    if (err == ESP_ERR_INVALID_STATE || err == ESP_ERR_TIMEOUT) {
-      _txBusy = false;
-      return Status(Err::RESOURCE_BUSY, err, "rmt busy");
+
+    uint8_t pixels = count;
+#if STATUSLED_IDF5_TX_LOOP
+    if (_chains == 1 && count > 1 && isUniform(frame, count)) {
+      txConfig.loop_count = count;
+      pixels = 1;
     }
-    if (err != ESP_OK) {
-      _txBusy = false;
-      return Status(Err::HARDWARE_FAULT, err, "rmt_transmit failed");
+#endif
+    for (uint8_t i = 0; i < pixels; ++i) {
+      const RgbColor mapped = mapColorOrder(frame[i], ColorOrder::RGB, order);
+      _payload[i * kBytesPerLed] = mapped.r;
+      _payload[i * kBytesPerLed + 1] = mapped.g;
+      _payload[i * kBytesPerLed + 2] = mapped.b;
     }
 
-    return Ok();
+    for (uint8_t c = 0; c < _chains; ++c) {
+      const uint8_t first = static_cast<uint8_t>(c * _chainLength);
+      const uint8_t left = static_cast<uint8_t>(pixels - first);
+      const uint8_t n = (_chains == 1 || left < _chainLength) ? left : _chainLength;
+      const esp_err_t err = rmt_transmit(_chans[c], _encoders[c], &_payload[first * kBytesPerLed],
+                                         n * kBytesPerLed, &txConfig);
+      if (err != ESP_OK) {
+        // Chains queued so far wait for the rest of the group: drop them.
+        if (c > 0 && !resetChannels().ok()) {
+          uninstall();  // Rebuilt by recoverStall()
+        }
+        return err;
+      }
+    }
+    return ESP_OK;
+  }
+
+  bool holdoffActive() const {
+    if (!_holdoff) {
+      return false;
+    }
+    if (esp_timer_get_time() < _holdoffUntilUs) {
+      return true;
+    }
+    _holdoff = false;
+    return false;
   }
 
- private:
   static bool onTxDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t* data, void* userCtx) {
-    (void)channel;
     (void)data;
     BackendIdf5Ws2812* self = static_cast<BackendIdf5Ws2812*>(userCtx);
-    if (self != nullptr) {
-      self->_txBusy = false;
+    if (self == nullptr) {
+      return false;
     }
-    return false;
+    uint8_t bit = 0;
+    for (uint8_t c = 0; c < self->_chains; ++c) {
+      if (self->_chans[c] == channel) {
+        bit = static_cast<uint8_t>(1u << c);
+      }
+    }
+    if ((self->_txBusy & bit) == 0) {
+      return false;  // Not part of a frame (blanking in end())
+    }
+    self->_txBusy = static_cast<uint8_t>(self->_txBusy & ~bit);
+    if (self->_txBusy != 0) {
+      return false;  // Longer chains still shifting
+    }
+    self->_txDoneUs = esp_timer_get_time();
+    const FrameDoneCallback callback = self->_doneCallback;
+    return (callback != nullptr) ? callback(self->_doneUser) : false;
   }
 
   static constexpr uint32_t kRmtResolutionHz = 40000000;   // 40MHz
@@ -210,16 +492,37 @@ class BackendIdf5Ws2812 final : public BackendBase {
   static constexpr uint16_t kT1H = 32;                     // 0.8us
   static constexpr uint16_t kT1L = 18;                     // 0.45us
   static constexpr uint32_t kMemBlockSymbols = 64;
+  static constexpr uint32_t kChainMemBlockSymbols = STATUSLED_IDF5_CHAIN_MEM_SYMBOLS;
   static constexpr uint32_t kCleanupWaitMs = 10;
+  static constexpr int64_t kLatchUs = 300;                 // WS2812B reset >= 280us
+  static constexpr int64_t kWireUsPerLed = 30;             // 24 bits at 800kHz
+  // Completion may legitimately lag behind the wire (ISRs deferred during flash writes).
+  static constexpr int64_t kTxTimeoutMarginUs = 20000;
   static constexpr uint8_t kMaxLeds = ::StatusLed::StatusLed::kMaxLedCount;
   static constexpr size_t kBytesPerLed = 3;
   static constexpr size_t kMaxPayloadBytes = kMaxLeds * kBytesPerLed;
 
-  rmt_channel_handle_t _tx_chan = nullptr;
-  rmt_encoder_handle_t _bytes_encoder = nullptr;
+  gpio_num_t _gpios[kMaxChains]{};
+  gpio_num_t _powerPin = GPIO_NUM_NC;
+  bool _powerActiveHigh = true;
+  uint8_t _chains = 0;
+  uint8_t _chainLength = 0;
+  rmt_channel_handle_t _chans[kMaxChains]{};
+  rmt_encoder_handle_t _encoders[kMaxChains]{};
+#if STATUSLED_IDF5_TX_SYNC
+  rmt_sync_manager_handle_t _sync = nullptr;
+#endif
   bool _installed = false;
+  bool _stallRebuild = false;  ///< Pending reinstall recovers an overdue transmit
   uint8_t _count = 0;
-  volatile bool _txBusy = false;
+  uint8_t _payload[kMaxPayloadBytes]{};  ///< Read by the encoders until the frame completes
+  volatile uint8_t _txBusy = 0;  ///< Bit per chain still transmitting; cleared by onTxDone (ISR)
+  mutable bool _holdoff = false;
+  int64_t _holdoffUntilUs = 0;
+  int64_t _txDeadlineUs = 0;
+  volatile int64_t _txDoneUs = 0;  ///< Set by onTxDone (ISR)
+  FrameDoneCallback volatile _doneCallback = nullptr;  ///< Read by onTxDone (ISR)
+  void* volatile _doneUser = nullptr;
 };
 
 }  // namespace
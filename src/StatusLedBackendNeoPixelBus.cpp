@@ -49,8 +49,20 @@ class BackendNeoPixelBus final : public BackendBase {
     if (config.ledCount == 0) {
       return Status(Err::INVALID_CONFIG, 0, "ledCount must be > 0");
     }
+    if (chainCount(config) > 1) {
+      return Status(Err::UNSUPPORTED, chainCount(config), "chainPins need the IDF5 backend");
+    }
+    if (config.powerPin > 255) {
+      return Status(Err::INVALID_CONFIG, config.powerPin, "powerPin out of range");
+    }
     _pin = static_cast<uint8_t>(config.dataPin);
     _count = config.ledCount;
+    if (config.powerPin >= 0) {
+      _powerPin = config.powerPin;
+      _powerActiveHigh = config.powerActiveHigh;
+      pinMode(static_cast<uint8_t>(_powerPin), OUTPUT);
+      setPower(true);
+    }
 
     switch (config.rmtChannel) {
       case 0:
@@ -86,10 +98,20 @@ class BackendNeoPixelBus final : public BackendBase {
       delete _bus;
       _bus = nullptr;
     }
+    _powerPin = -1;  // Rail left as is
+  }
+
+  Status setPower(bool on) override {
+    if (_powerPin >= 0) {
+      digitalWrite(static_cast<uint8_t>(_powerPin), on == _powerActiveHigh ? HIGH : LOW);
+    }
+    return Ok();
   }
 
   bool canShow() const override { return _bus ? _bus->canShow() : false; }
 
+  uint32_t nowUs() const override { return static_cast<uint32_t>(micros()); }
+
   Status show(const RgbColor* frame, uint8_t count, ColorOrder order) override {
     if (_bus == nullptr) {
       return Status(Err::NOT_INITIALIZED, 0, "Backend not initialized");
@@ -122,6 +144,8 @@ class BackendNeoPixelBus final : public BackendBase {
   NeoPixelBusWrapperBase* _bus = nullptr;
   uint8_t _count = 0;
   uint8_t _pin = 0;
+  int _powerPin = -1;
+  bool _powerActiveHigh = true;
 };
 
 }  // namespace
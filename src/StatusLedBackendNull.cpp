@@ -5,7 +5,7 @@
 
 #include "StatusLedBackend.h"
 
-#if STATUSLED_BACKEND_NULL
+#if STATUSLED_BACKEND_NULL && !STATUSLED_TEST
 
 #include <new>
 
@@ -32,4 +32,4 @@ void destroyBackend(BackendBase* backend) {
 
 }  // namespace StatusLed
 
-#endif  // STATUSLED_BACKEND_NULL
+#endif  // STATUSLED_BACKEND_NULL && !STATUSLED_TEST
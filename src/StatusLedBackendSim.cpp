@@ -0,0 +1,248 @@
+/**
+ * @file StatusLedBackendSim.cpp
+ * @brief Simulated wire backend for host tests (STATUSLED_TEST builds).
+ */
+
+#include "StatusLedBackend.h"
+#include "StatusLedBackendSim.h"
+#include "StatusLedInternal.h"
+
+#if STATUSLED_BACKEND_NULL && STATUSLED_TEST
+
+#include <new>
+
+namespace StatusLed {
+namespace sim {
+namespace {
+
+struct SimWire {
+  SimConfig config{};
+  uint32_t nowUs = 0;
+  bool busy = false;
+  uint32_t freeAtUs = 0;  ///< Line usable again (end of latch gap)
+  bool hasStarted = false;
+  bool hasLatched = false;
+  bool currentDone = false;      ///< In-flight frame reached its latch time
+  bool completionLost = false;   ///< In-flight frame never reports completion
+  uint32_t losePending = 0;
+  bool railOn = true;
+  uint32_t railOnUs = 0;
+  FrameDoneCallback doneCallback = nullptr;  ///< Fired when a frame completes
+  void* doneUser = nullptr;
+  SimFrame current{};
+  SimFrame latched{};
+  SimStats stats{};
+};
+
+static SimWire g_wire;
+
+static bool reached(uint32_t now, uint32_t target) {
+  return static_cast<uint32_t>(now - target) < 0x80000000u;
+}
+
+// Retire the in-flight frame once its latch time has passed.
+static void settle() {
+  if (!g_wire.busy || !reached(g_wire.nowUs, g_wire.freeAtUs)) {
+    return;
+  }
+  if (!g_wire.currentDone) {
+    g_wire.currentDone = true;
+    if (!g_wire.current.aborted) {
+      g_wire.latched = g_wire.current;
+      g_wire.hasLatched = true;
+      ++g_wire.stats.latched;
+    }
+  }
+  if (!g_wire.completionLost) {
+    g_wire.busy = false;
+    if (!g_wire.current.aborted && g_wire.doneCallback != nullptr) {
+      ++g_wire.stats.doneCallbacks;
+      g_wire.doneCallback(g_wire.doneUser);
+    }
+  }
+}
+
+}  // namespace
+
+void reset(const SimConfig& config) {
+  g_wire = SimWire();
+  g_wire.config = config;
+}
+
+void setTimeUs(uint32_t nowUs) {
+  g_wire.nowUs = nowUs;
+  settle();
+}
+
+uint32_t timeUs() { return g_wire.nowUs; }
+
+SimStats stats() {
+  settle();
+  return g_wire.stats;
+}
+
+void loseCompletions(uint32_t frames) { g_wire.losePending = frames; }
+
+bool railPowered() { return g_wire.railOn; }
+
+uint32_t railOnUs() { return g_wire.railOnUs; }
+
+bool lastStarted(SimFrame* out) {
+  settle();
+  if (out == nullptr || !g_wire.hasStarted) {
+    return false;
+  }
+  *out = g_wire.current;
+  return true;
+}
+
+bool lastLatched(SimFrame* out) {
+  settle();
+  if (out == nullptr || !g_wire.hasLatched) {
+    return false;
+  }
+  *out = g_wire.latched;
+  return true;
+}
+
+}  // namespace sim
+
+namespace {
+
+class BackendSim final : public BackendBase {
+ public:
+  Status begin(const Config& config) override {
+    _count = config.ledCount;
+    // Chains start together: the wire is busy for the longest one.
+    _chainLength = (chainCount(config) > 1) ? config.chainLength : config.ledCount;
+    _hasPowerPin = config.powerPin >= 0;
+    return setPower(true);
+  }
+
+  void end() override {
+    sim::g_wire.doneCallback = nullptr;
+    _count = 0;
+    _hasPowerPin = false;
+  }
+
+  bool canShow() const override {
+    sim::settle();
+    return !sim::g_wire.busy;
+  }
+
+  Status show(const RgbColor* frame, uint8_t count, ColorOrder) override {
+    if (frame == nullptr) {
+      return Status(Err::INVALID_CONFIG, 0, "frame must not be null");
+    }
+    if (count == 0 || count > _count) {
+      return Status(Err::INVALID_CONFIG, count, "count out of range");
+    }
+    sim::settle();
+    sim::SimWire& wire = sim::g_wire;
+    if (wire.busy) {
+      ++wire.stats.busyRejects;
+      return Status(Err::RESOURCE_BUSY, 0, "sim busy");
+    }
+
+    wire.current = sim::SimFrame();
+    wire.current.startUs = wire.nowUs;
+    wire.current.count = count;
+    for (uint8_t i = 0; i < count; ++i) {
+      wire.current.pixels[i] = frame[i];
+    }
+    const uint8_t longest = (count < _chainLength) ? count : _chainLength;
+    wire.current.latchUs = wire.nowUs + longest * wire.config.usPerLed + wire.config.latchUs;
+    wire.freeAtUs = wire.current.latchUs;
+    wire.busy = true;
+    wire.currentDone = false;
+    wire.completionLost = wire.losePending > 0;
+    if (wire.completionLost) {
+      --wire.losePending;
+      ++wire.stats.lostCompletions;
+    }
+    wire.hasStarted = true;
+    ++wire.stats.started;
+    if (!wire.railOn) {
+      ++wire.stats.unpoweredFrames;
+    }
+    return Ok();
+  }
+
+  Status abortShow() override {
+    sim::SimWire& wire = sim::g_wire;
+    if (!wire.config.supportsAbort) {
+      return Status(Err::UNSUPPORTED, 0, "abort not supported");
+    }
+    sim::settle();
+    if (!wire.busy || wire.current.aborted) {
+      return Ok();
+    }
+    // Partially shifted data is discarded by the next reset; hold the line low for one latch gap.
+    wire.current.aborted = !wire.currentDone;
+    wire.completionLost = false;  // The driver abort path does not wait for completion
+    wire.freeAtUs = wire.nowUs + wire.config.latchUs;
+    ++wire.stats.aborted;
+    return Ok();
+  }
+
+  Status recoverStall() override {
+    sim::settle();
+    sim::SimWire& wire = sim::g_wire;
+    if (!wire.busy || !wire.completionLost ||
+        !sim::reached(wire.nowUs, wire.current.latchUs + wire.config.txTimeoutMarginUs)) {
+      return Ok();
+    }
+    wire.completionLost = false;
+    wire.busy = false;
+    ++wire.stats.stallRecoveries;
+    return Status(Err::TIMEOUT, 0, "sim done callback lost");
+  }
+
+  Status setPower(bool on) override {
+    sim::SimWire& wire = sim::g_wire;
+    if (!_hasPowerPin || wire.railOn == on) {
+      return Ok();
+    }
+    sim::settle();
+    wire.railOn = on;
+    if (on) {
+      wire.railOnUs = wire.nowUs;
+      ++wire.stats.powerOns;
+    } else {
+      for (RgbColor& pixel : wire.latched.pixels) {
+        pixel = RgbColor();  // LEDs forget their state without supply
+      }
+      ++wire.stats.powerOffs;
+    }
+    return Ok();
+  }
+
+  Status setDoneCallback(FrameDoneCallback callback, void* user) override {
+    sim::g_wire.doneCallback = callback;
+    sim::g_wire.doneUser = user;
+    return Ok();
+  }
+
+  uint32_t nowUs() const override { return sim::g_wire.nowUs; }
+
+  uint32_t lastDoneUs() const override { return sim::g_wire.current.latchUs; }
+
+ private:
+  uint8_t _count = 0;
+  uint8_t _chainLength = 0;
+  bool _hasPowerPin = false;
+};
+
+}  // namespace
+
+BackendBase* createBackend() {
+  return new (std::nothrow) BackendSim();
+}
+
+void destroyBackend(BackendBase* backend) {
+  delete backend;
+}
+
+}  // namespace StatusLed
+
+#endif  // STATUSLED_BACKEND_NULL && STATUSLED_TEST
@@ -0,0 +1,85 @@
+/**
+ * @file StatusLedBackendSim.h
+ * @brief Simulated wire backend for host tests (STATUSLED_TEST builds).
+ *
+ * Models WS2812 wire time on a test-driven microsecond clock so tests can
+ * measure change-to-wire latency and inject driver faults. Config::powerPin
+ * drives a mock rail GPIO: unpowered LEDs lose the frame they were showing.
+ */
+
+#pragma once
+
+#include "StatusLed/StatusLed.h"
+
+#if STATUSLED_BACKEND_NULL && STATUSLED_TEST
+
+namespace StatusLed {
+namespace sim {
+
+/// @brief Wire model parameters.
+struct SimConfig {
+  uint32_t usPerLed = 30;      ///< 24 bits at 800 kHz
+  uint32_t latchUs = 80;       ///< Reset/latch gap after data
+  bool supportsAbort = true;   ///< abortShow() available
+  uint32_t txTimeoutMarginUs = 20000;  ///< Completion deadline past the latch time
+};
+
+/// @brief One frame as seen on the wire.
+struct SimFrame {
+  uint32_t startUs = 0;
+  uint32_t latchUs = 0;        ///< Time the LEDs display this frame
+  bool aborted = false;
+  uint8_t count = 0;
+  RgbColor pixels[StatusLed::kMaxLedCount]{};
+};
+
+/// @brief Wire counters.
+struct SimStats {
+  uint32_t started = 0;
+  uint32_t latched = 0;
+  uint32_t aborted = 0;
+  uint32_t busyRejects = 0;
+  uint32_t lostCompletions = 0;  ///< Frames whose completion was dropped
+  uint32_t stallRecoveries = 0;  ///< Deadlines that expired and freed the wire
+  uint32_t powerOns = 0;         ///< Rail switched on (Config::powerPin)
+  uint32_t powerOffs = 0;        ///< Rail switched off
+  uint32_t doneCallbacks = 0;    ///< Completion callbacks fired
+  uint32_t unpoweredFrames = 0;  ///< Frames started while the rail was off
+};
+
+/// @brief Reset the simulated wire (clock, frames, stats).
+void reset(const SimConfig& config = SimConfig());
+
+/// @brief Set the simulated clock (microseconds, wraps like esp_timer low bits).
+void setTimeUs(uint32_t nowUs);
+
+/// @brief Current simulated clock.
+uint32_t timeUs();
+
+/// @brief Wire counters, updated lazily against the clock.
+SimStats stats();
+
+/**
+ * @brief Drop the completion of the next `frames` frames.
+ *
+ * The frame still reaches the LEDs, but the wire stays busy until the
+ * backend's transmit deadline recovers it (like a lost RMT done interrupt).
+ */
+void loseCompletions(uint32_t frames);
+
+/// @brief Mock rail GPIO state (true when no power pin is configured).
+bool railPowered();
+
+/// @brief Time the rail last switched on.
+uint32_t railOnUs();
+
+/// @brief Most recently started frame (false if none).
+bool lastStarted(SimFrame* out);
+
+/// @brief Most recently latched (displayed) frame (false if none).
+bool lastLatched(SimFrame* out);
+
+}  // namespace sim
+}  // namespace StatusLed
+
+#endif  // STATUSLED_BACKEND_NULL && STATUSLED_TEST
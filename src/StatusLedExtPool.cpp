@@ -0,0 +1,72 @@
+/**
+ * @file StatusLedExtPool.cpp
+ * @brief Extension block pool.
+ */
+
+#include "StatusLed/ExtPool.h"
+
+#include <new>
+
+namespace StatusLed {
+
+static_assert(kExtBlockSize % sizeof(uintptr_t) == 0, "blocks stay pointer-aligned");
+
+ExtPool::~ExtPool() { end(); }
+
+Status ExtPool::begin(uint8_t count) {
+  end();
+  if (count > kMaxExtBlocks) {
+    return Status(Err::INVALID_CONFIG, count, "extBlockCount out of range");
+  }
+  if (count == 0) {
+    return Ok();
+  }
+  _storage = new (std::nothrow) uintptr_t[static_cast<size_t>(count) * kExtBlockSize / sizeof(uintptr_t)];
+  if (_storage == nullptr) {
+    return Status(Err::OUT_OF_MEMORY, count, "extension pool alloc failed");
+  }
+  _capacity = count;
+  _available = count;
+  for (uint8_t i = 0; i < count; ++i) {
+    data(i)[0] = static_cast<uint8_t>(i + 1 < count ? i + 1 : kNoExtBlock);
+  }
+  _freeHead = 0;
+  return Ok();
+}
+
+void ExtPool::end() {
+  delete[] _storage;
+  _storage = nullptr;
+  _inUse = 0;
+  _capacity = 0;
+  _available = 0;
+  _freeHead = kNoExtBlock;
+}
+
+Status ExtPool::acquire(uint8_t* out) {
+  if (out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "out must not be null");
+  }
+  *out = kNoExtBlock;
+  if (_freeHead == kNoExtBlock) {
+    return Status(Err::OUT_OF_MEMORY, _capacity, "extension pool exhausted");
+  }
+  const uint8_t block = _freeHead;
+  _freeHead = data(block)[0];
+  _inUse |= (1ull << block);
+  --_available;
+  *out = block;
+  return Ok();
+}
+
+void ExtPool::release(uint8_t block) {
+  if (block >= _capacity || (_inUse & (1ull << block)) == 0) {
+    return;
+  }
+  _inUse &= ~(1ull << block);
+  data(block)[0] = _freeHead;
+  _freeHead = block;
+  ++_available;
+}
+
+}  // namespace StatusLed
@@ -16,4 +16,41 @@ inline RgbColor mapColorOrder(const RgbColor& color, ColorOrder srcOrder, ColorO
   return RgbColor(color.g, color.r, color.b);
 }
 
+/// Chains configured by Config::chainPins (1 = dataPin only).
+inline uint8_t chainCount(const Config& config) {
+  uint8_t n = 1;
+  while (n < kMaxChains && config.chainPins[n - 1] >= 0) {
+    ++n;
+  }
+  return n;
+}
+
+inline bool isValidMode(Mode mode) {
+  switch (mode) {
+    case Mode::Off:
+    case Mode::Solid:
+    case Mode::Dim:
+    case Mode::BlinkSlow:
+    case Mode::BlinkFast:
+    case Mode::DoubleBlink:
+    case Mode::TripleBlink:
+    case Mode::Beacon:
+    case Mode::Strobe:
+    case Mode::FadeIn:
+    case Mode::FadeOut:
+    case Mode::PulseSoft:
+    case Mode::PulseSharp:
+    case Mode::Breathing:
+    case Mode::Heartbeat:
+    case Mode::Throb:
+    case Mode::FlickerCandle:
+    case Mode::Glitch:
+    case Mode::Alternate:
+    case Mode::SOS:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace StatusLed
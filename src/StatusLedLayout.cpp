@@ -0,0 +1,94 @@
+/**
+ * @file StatusLedLayout.cpp
+ * @brief Layout compilation.
+ */
+
+#include "StatusLed/Layout.h"
+
+#include <string.h>
+
+namespace StatusLed {
+
+void LayoutTable::compileLinear(uint8_t ledCount, bool reversed) {
+  _width = ledCount;
+  _height = 1;
+  memset(_cell, kNoLayoutLed, sizeof(_cell));
+  for (uint8_t i = 0; i < ledCount; ++i) {
+    const uint8_t x = reversed ? static_cast<uint8_t>(ledCount - 1 - i) : i;
+    _x[i] = x;
+    _y[i] = 0;
+    _cell[x] = i;
+  }
+}
+
+Status LayoutTable::compile(const Layout& layout, uint8_t ledCount) {
+  if (ledCount == 0 || ledCount > kMaxLayoutLeds) {
+    return Status(Err::INVALID_CONFIG, ledCount, "ledCount out of range");
+  }
+  const bool linear = layout.kind == LayoutKind::Linear;
+  compileLinear(ledCount, linear && layout.reversed);
+  if (linear) {
+    return Ok();
+  }
+  if (layout.kind != LayoutKind::Matrix && layout.kind != LayoutKind::Map) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(layout.kind), "invalid layout kind");
+  }
+
+  const uint16_t cells = static_cast<uint16_t>(layout.width) * layout.height;
+  if (layout.width == 0 || layout.height == 0 || cells > kMaxLayoutCells) {
+    return Status(Err::INVALID_CONFIG, cells, "layout size out of range");
+  }
+
+  uint8_t cell[kMaxLayoutCells];
+  memset(cell, kNoLayoutLed, sizeof(cell));
+  if (layout.kind == LayoutKind::Matrix) {
+    if (cells < ledCount) {
+      return Status(Err::INVALID_CONFIG, cells, "layout smaller than ledCount");
+    }
+    for (uint8_t i = 0; i < ledCount; ++i) {
+      // Position along the wiring path, then fold the path into rows.
+      const uint8_t p = layout.reversed ? static_cast<uint8_t>(cells - 1 - i) : i;
+      const uint8_t row = static_cast<uint8_t>(p / layout.width);
+      uint8_t col = static_cast<uint8_t>(p % layout.width);
+      if (layout.serpentine && (row & 1u) != 0) {
+        col = static_cast<uint8_t>(layout.width - 1 - col);
+      }
+      cell[row * layout.width + col] = i;
+    }
+  } else {
+    if (layout.map == nullptr) {
+      return Status(Err::INVALID_CONFIG, 0, "layout map must not be null");
+    }
+    uint16_t seen = 0;
+    for (uint8_t c = 0; c < cells; ++c) {
+      uint8_t index = layout.map[c];
+      if (index == kNoLayoutLed) {
+        continue;
+      }
+      if (index >= ledCount || (seen & (1u << index)) != 0) {
+        return Status(Err::INVALID_CONFIG, c, "layout map entry invalid or duplicate");
+      }
+      seen = static_cast<uint16_t>(seen | (1u << index));
+      if (layout.reversed) {
+        index = static_cast<uint8_t>(ledCount - 1 - index);
+      }
+      cell[c] = index;
+    }
+    if (seen != static_cast<uint16_t>((1u << ledCount) - 1u)) {
+      return Status(Err::INVALID_CONFIG, 0, "layout map misses an LED");
+    }
+  }
+
+  _width = layout.width;
+  _height = layout.height;
+  memcpy(_cell, cell, sizeof(_cell));
+  for (uint8_t c = 0; c < cells; ++c) {
+    if (cell[c] != kNoLayoutLed) {
+      _x[cell[c]] = static_cast<uint8_t>(c % layout.width);
+      _y[cell[c]] = static_cast<uint8_t>(c / layout.width);
+    }
+  }
+  return Ok();
+}
+
+}  // namespace StatusLed
@@ -0,0 +1,250 @@
+/**
+ * @file StatusLedPack.cpp
+ * @brief Pack validation and platform mapping helpers.
+ */
+
+#include "StatusLed/Pack.h"
+#include "StatusLedInternal.h"
+
+#include <stddef.h>
+
+#if STATUSLED_BACKEND_NULL
+#if defined(__unix__) || defined(__APPLE__)
+#define STATUSLED_PACK_POSIX_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#else
+#define STATUSLED_PACK_ESP_PARTITION 1
+extern "C" {
+#include "esp_idf_version.h"
+#include "esp_partition.h"
+#if ESP_IDF_VERSION_MAJOR < 5
+#include "esp_spi_flash.h"
+#endif
+}
+#endif
+
+namespace StatusLed {
+namespace {
+
+static uint32_t crc32(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+static bool tableFits(const PackTable& t, size_t recordSize, uint32_t headerSize,
+                      uint32_t totalSize) {
+  if (t.count == 0) {
+    return true;
+  }
+  if ((t.offset % kPackAlignment) != 0 || t.offset < headerSize || t.offset > totalSize) {
+    return false;
+  }
+  return t.count <= (totalSize - t.offset) / recordSize;
+}
+
+static bool sliceFits(uint32_t first, uint32_t count, uint32_t tableCount) {
+  return count > 0 && first < tableCount && count <= tableCount - first;
+}
+
+}  // namespace
+
+Status PackView::open(const void* data, size_t size, PackView* out) {
+  if (out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "out must not be null");
+  }
+  *out = PackView();
+  if (data == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "pack data must not be null");
+  }
+  if ((reinterpret_cast<uintptr_t>(data) % kPackAlignment) != 0) {
+    return Status(Err::INVALID_CONFIG, 0, "pack data misaligned");
+  }
+  if (size < sizeof(PackHeader)) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(size), "pack too small");
+  }
+
+  const uint8_t* base = static_cast<const uint8_t*>(data);
+  const PackHeader& h = *reinterpret_cast<const PackHeader*>(base);
+  if (h.magic != kPackMagic) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(h.magic), "pack magic mismatch");
+  }
+  if (h.version != kPackFormatVersion) {
+    return Status(Err::UNSUPPORTED, h.version, "pack version unsupported");
+  }
+  if (h.headerSize < sizeof(PackHeader) || (h.headerSize % kPackAlignment) != 0) {
+    return Status(Err::INVALID_CONFIG, h.headerSize, "pack headerSize invalid");
+  }
+  if (h.totalSize < h.headerSize || h.totalSize > size) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(h.totalSize), "pack totalSize invalid");
+  }
+  if (crc32(base + h.headerSize, h.totalSize - h.headerSize) != h.crc32) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(h.crc32), "pack crc mismatch");
+  }
+
+  if (!tableFits(h.patterns, sizeof(PackPattern), h.headerSize, h.totalSize) ||
+      !tableFits(h.steps, sizeof(PackStep), h.headerSize, h.totalSize) ||
+      !tableFits(h.tracks, sizeof(PackTrack), h.headerSize, h.totalSize) ||
+      !tableFits(h.keyframes, sizeof(PackKeyframe), h.headerSize, h.totalSize) ||
+      !tableFits(h.palettes, sizeof(PackPalette), h.headerSize, h.totalSize) ||
+      !tableFits(h.colors, sizeof(PackColor), h.headerSize, h.totalSize) ||
+      !tableFits(h.presets, sizeof(PackPreset), h.headerSize, h.totalSize)) {
+    return Status(Err::INVALID_CONFIG, 0, "pack table out of bounds");
+  }
+  if (h.patterns.count > 0xFFFFu || h.tracks.count > 0xFFFFu || h.palettes.count > 0xFFFFu ||
+      h.presets.count > 0xFFFFu) {
+    return Status(Err::INVALID_CONFIG, 0, "pack table too large");
+  }
+
+  PackView view;
+  view._base = base;
+
+  for (uint32_t i = 0; i < h.steps.count; ++i) {
+    if (view.step(i).durationMs == 0) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack step duration is zero");
+    }
+  }
+  for (uint32_t i = 0; i < h.patterns.count; ++i) {
+    const PackPattern& p = view.pattern(static_cast<uint16_t>(i));
+    if (!sliceFits(p.firstStep, p.stepCount, h.steps.count)) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack pattern steps out of range");
+    }
+  }
+  for (uint32_t i = 0; i < h.tracks.count; ++i) {
+    const PackTrack& t = view.track(static_cast<uint16_t>(i));
+    if (!sliceFits(t.firstKey, t.keyCount, h.keyframes.count) || t.durationMs == 0) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack track invalid");
+    }
+    uint32_t lastTime = 0;
+    for (uint16_t k = 0; k < t.keyCount; ++k) {
+      const uint32_t time = view.keyframe(static_cast<uint32_t>(t.firstKey) + k).timeMs;
+      if ((k > 0 && time <= lastTime) || time > t.durationMs) {
+        return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack track keyframes unordered");
+      }
+      lastTime = time;
+    }
+  }
+  for (uint32_t i = 0; i < h.palettes.count; ++i) {
+    const PackPalette& p = view.palette(static_cast<uint16_t>(i));
+    if (!sliceFits(p.firstColor, p.colorCount, h.colors.count)) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack palette colors out of range");
+    }
+  }
+  for (uint32_t i = 0; i < h.presets.count; ++i) {
+    const PackPreset& p = view.preset(static_cast<uint16_t>(i));
+    bool refOk = false;
+    switch (static_cast<PackPresetKind>(p.kind)) {
+      case PackPresetKind::BuiltinMode:
+        refOk = p.ref <= 0xFFu && isValidMode(static_cast<Mode>(p.ref));
+        break;
+      case PackPresetKind::Pattern:
+        refOk = p.ref < h.patterns.count;
+        break;
+      case PackPresetKind::Track:
+        refOk = p.ref < h.tracks.count;
+        break;
+      default:
+        break;
+    }
+    if (!refOk) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack preset ref invalid");
+    }
+    if (p.palette >= h.palettes.count) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack preset palette invalid");
+    }
+    const PackPalette& pal = view.palette(p.palette);
+    if (p.primary >= pal.colorCount || p.secondary >= pal.colorCount) {
+      return Status(Err::INVALID_CONFIG, static_cast<int32_t>(i), "pack preset color invalid");
+    }
+  }
+
+  *out = view;
+  return Ok();
+}
+
+Status mapPackPartition(const char* label, PackMapping* out) {
+  if (label == nullptr || out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "label/out must not be null");
+  }
+  *out = PackMapping();
+#if defined(STATUSLED_PACK_ESP_PARTITION)
+  const esp_partition_t* part =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (part == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "pack partition not found");
+  }
+  const void* ptr = nullptr;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t handle = 0;
+  const esp_err_t err =
+      esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+#else
+  spi_flash_mmap_handle_t handle = 0;
+  const esp_err_t err = esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &ptr, &handle);
+#endif
+  if (err != ESP_OK) {
+    return Status(Err::HARDWARE_FAULT, err, "esp_partition_mmap failed");
+  }
+  out->data = ptr;
+  out->size = part->size;
+  out->handle = static_cast<uint32_t>(handle);
+  return Ok();
+#else
+  return Status(Err::UNSUPPORTED, 0, "partitions not available on this target");
+#endif
+}
+
+Status mapPackFile(const char* path, PackMapping* out) {
+  if (path == nullptr || out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "path/out must not be null");
+  }
+  *out = PackMapping();
+#if defined(STATUSLED_PACK_POSIX_MMAP)
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return Status(Err::INVALID_CONFIG, 0, "pack file open failed");
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return Status(Err::INVALID_CONFIG, 0, "pack file empty");
+  }
+  void* ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (ptr == MAP_FAILED) {
+    return Status(Err::EXTERNAL_LIB_ERROR, 0, "mmap failed");
+  }
+  out->data = ptr;
+  out->size = static_cast<size_t>(st.st_size);
+  return Ok();
+#else
+  return Status(Err::UNSUPPORTED, 0, "file mapping not available on this target");
+#endif
+}
+
+void unmapPack(PackMapping* mapping) {
+  if (mapping == nullptr || mapping->data == nullptr) {
+    return;
+  }
+#if defined(STATUSLED_PACK_ESP_PARTITION)
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_munmap(static_cast<esp_partition_mmap_handle_t>(mapping->handle));
+#else
+  spi_flash_munmap(static_cast<spi_flash_mmap_handle_t>(mapping->handle));
+#endif
+#elif defined(STATUSLED_PACK_POSIX_MMAP)
+  munmap(const_cast<void*>(mapping->data), mapping->size);
+#endif
+  *mapping = PackMapping();
+}
+
+}  // namespace StatusLed
@@ -0,0 +1,386 @@
+/**
+ * @file StatusLedSerializer.cpp
+ * @brief Streaming JSON/CBOR writer.
+ */
+
+#include "StatusLed/Serializer.h"
+
+#include <string.h>
+
+namespace StatusLed {
+
+namespace {
+
+// Indexed by enum value; keep in declaration order.
+const char* const kModeNames[] = {
+    "off",       "solid",      "dim",       "blinkslow",   "blinkfast",   "doubleblink",
+    "tripleblink", "beacon",   "strobe",    "fadein",      "fadeout",     "pulsesoft",
+    "pulsesharp", "breathing", "heartbeat", "throb",       "flicker",     "glitch",
+    "alternate", "sos",        "packpattern", "packtrack", "custom",      "spatial"};
+
+const char* const kPresetNames[] = {
+    "off",  "ready",       "busy",   "warning", "error",   "critical",   "updating",
+    "info", "maintenance", "police", "hazard",  "success", "connecting", "lowbat"};
+
+static_assert(sizeof(kModeNames) / sizeof(kModeNames[0]) ==
+                  static_cast<size_t>(Mode::Spatial) + 1,
+              "kModeNames out of sync with Mode");
+static_assert(sizeof(kPresetNames) / sizeof(kPresetNames[0]) ==
+                  static_cast<size_t>(StatusPreset::LowBattery) + 1,
+              "kPresetNames out of sync with StatusPreset");
+
+// Fields per LED object.
+constexpr uint8_t kLedFields = 12;
+
+/**
+ * Emits JSON or CBOR tokens. Buffer output is written in place; sink output
+ * goes through a stack chunk. Errors are sticky and reported by finish().
+ */
+class Writer {
+ public:
+  Writer(SerialOutput* out, SerialFormat format) : _out(out), _json(format == SerialFormat::Json) {
+    _out->written = 0;
+  }
+
+  void beginMap(uint8_t fields) {
+    if (_json) {
+      open('{');
+    } else {
+      head(5, fields);
+    }
+  }
+
+  void endMap() { close('}'); }
+
+  void beginArray(uint8_t items) {
+    if (_json) {
+      open('[');
+    } else {
+      head(4, items);
+    }
+  }
+
+  /// Array whose length is not known up front (CBOR indefinite-length).
+  void beginStream() {
+    if (_json) {
+      open('[');
+    } else {
+      byte(0x9F);
+    }
+  }
+
+  void endArray() { close(']'); }
+
+  void endStream() {
+    if (_json) {
+      close(']');
+    } else {
+      byte(0xFF);
+    }
+  }
+
+  void key(const char* name) {
+    if (_json) {
+      separate();
+      quoted(name);
+      byte(':');
+      _afterKey = true;
+    } else {
+      text(name);
+    }
+  }
+
+  void uint(uint32_t value) {
+    if (!_json) {
+      head(0, value);
+      return;
+    }
+    valuePrefix();
+    char digits[10];
+    uint8_t n = 0;
+    do {
+      digits[n++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+      byte(static_cast<uint8_t>(digits[--n]));
+    }
+  }
+
+  void boolean(bool value) {
+    if (!_json) {
+      byte(value ? 0xF5 : 0xF4);
+      return;
+    }
+    valuePrefix();
+    raw(value ? "true" : "false");
+  }
+
+  void string(const char* value) {
+    if (_json) {
+      valuePrefix();
+      quoted(value);
+    } else {
+      text(value);
+    }
+  }
+
+  void rgb(const RgbColor& c) {
+    beginArray(3);
+    uint(c.r);
+    uint(c.g);
+    uint(c.b);
+    endArray();
+  }
+
+  bool ok() const { return !_sinkFailed; }
+
+  Status finish() {
+    if (_out->sink != nullptr) {
+      flush();
+      if (_sinkFailed) {
+        return Status(Err::EXTERNAL_LIB_ERROR, static_cast<int32_t>(_out->written),
+                      "serializer sink failed");
+      }
+      return Ok();
+    }
+    if (_out->buffer == nullptr) {
+      return Ok();  // Measure only
+    }
+    if (_out->written > _out->capacity) {
+      return Status(Err::OUT_OF_MEMORY, static_cast<int32_t>(_out->written),
+                    "serializer buffer too small");
+    }
+    if (_json && _out->written < _out->capacity) {
+      _out->buffer[_out->written] = '\0';
+    }
+    return Ok();
+  }
+
+ private:
+  void byte(uint8_t b) {
+    if (_out->sink != nullptr) {
+      if (_sinkFailed) {
+        return;
+      }
+      if (_used == sizeof(_chunk)) {
+        flush();
+      }
+      _chunk[_used++] = b;
+    } else if (_out->buffer != nullptr && _out->written < _out->capacity) {
+      _out->buffer[_out->written] = b;
+    }
+    ++_out->written;
+  }
+
+  void raw(const char* s) {
+    while (*s != '\0') {
+      byte(static_cast<uint8_t>(*s++));
+    }
+  }
+
+  void flush() {
+    if (_used == 0 || _sinkFailed) {
+      return;
+    }
+    if (!_out->sink(_chunk, _used, _out->user)) {
+      _sinkFailed = true;
+    }
+    _used = 0;
+  }
+
+  // CBOR major type + argument (RFC 8949 3.1).
+  void head(uint8_t major, uint32_t value) {
+    const uint8_t m = static_cast<uint8_t>(major << 5);
+    if (value < 24) {
+      byte(static_cast<uint8_t>(m | value));
+    } else if (value <= 0xFF) {
+      byte(static_cast<uint8_t>(m | 24));
+      byte(static_cast<uint8_t>(value));
+    } else if (value <= 0xFFFF) {
+      byte(static_cast<uint8_t>(m | 25));
+      byte(static_cast<uint8_t>(value >> 8));
+      byte(static_cast<uint8_t>(value));
+    } else {
+      byte(static_cast<uint8_t>(m | 26));
+      byte(static_cast<uint8_t>(value >> 24));
+      byte(static_cast<uint8_t>(value >> 16));
+      byte(static_cast<uint8_t>(value >> 8));
+      byte(static_cast<uint8_t>(value));
+    }
+  }
+
+  void text(const char* s) {
+    const size_t len = strlen(s);
+    head(3, static_cast<uint32_t>(len));
+    raw(s);
+  }
+
+  // Names come from static tables: plain ASCII, nothing to escape.
+  void quoted(const char* s) {
+    byte('"');
+    raw(s);
+    byte('"');
+  }
+
+  // JSON: comma before every member but the first of each container.
+  void separate() {
+    const uint8_t bit = static_cast<uint8_t>(1u << _depth);
+    if ((_hasMember & bit) != 0) {
+      byte(',');
+    }
+    _hasMember = static_cast<uint8_t>(_hasMember | bit);
+  }
+
+  void valuePrefix() {
+    if (_afterKey) {
+      _afterKey = false;
+    } else {
+      separate();
+    }
+  }
+
+  void open(char c) {
+    valuePrefix();
+    byte(static_cast<uint8_t>(c));
+    ++_depth;
+    _hasMember = static_cast<uint8_t>(_hasMember & ~(1u << _depth));
+  }
+
+  void close(char c) {
+    if (!_json) {
+      return;  // Definite-length CBOR containers need no terminator
+    }
+    --_depth;
+    byte(static_cast<uint8_t>(c));
+  }
+
+  SerialOutput* _out;
+  bool _json;
+  bool _afterKey = false;
+  bool _sinkFailed = false;
+  uint8_t _depth = 0;      // JSON nesting (documents stay below 8 levels)
+  uint8_t _hasMember = 0;  // JSON: bit per depth, container already has a member
+  size_t _used = 0;
+  uint8_t _chunk[kSerialChunkSize];
+};
+
+Status checkArgs(const StatusLed& leds, SerialFormat format, const SerialOutput* out) {
+  if (out == nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "out must not be null");
+  }
+  if (format != SerialFormat::Json && format != SerialFormat::Cbor) {
+    return Status(Err::INVALID_CONFIG, static_cast<int32_t>(format), "invalid serial format");
+  }
+  if (out->sink != nullptr && out->buffer != nullptr) {
+    return Status(Err::INVALID_CONFIG, 0, "set either buffer or sink");
+  }
+  if (out->buffer == nullptr && out->capacity != 0) {
+    return Status(Err::INVALID_CONFIG, 0, "buffer must not be null");
+  }
+  if (!leds.isInitialized()) {
+    return Status(Err::NOT_INITIALIZED, 0, "begin not called");
+  }
+  return Ok();
+}
+
+void writeLed(Writer& w, uint8_t index, const LedSnapshot& s) {
+  w.beginMap(kLedFields);
+  w.key("i");
+  w.uint(index);
+  w.key("v");
+  w.uint(s.version);
+  w.key("mode");
+  w.string(modeName(s.mode));
+  w.key("preset");
+  w.string(presetName(s.preset));
+  w.key("default");
+  w.string(presetName(s.defaultPreset));
+  w.key("color");
+  w.rgb(s.color);
+  w.key("alt");
+  w.rgb(s.altColor);
+  w.key("bri");
+  w.uint(s.brightness);
+  w.key("int");
+  w.uint(s.intensity);
+  w.key("temp");
+  w.boolean(s.tempActive);
+  w.key("tempMs");
+  w.uint(s.tempRemainingMs);
+  w.key("pack");
+  w.uint(s.packRef);
+  w.endMap();
+}
+
+// ChangeVisitor: streams one change entry; stops once the writer fails.
+bool writeChange(const LedChange& change, void* user) {
+  Writer& w = *static_cast<Writer*>(user);
+  writeLed(w, change.index, change.snapshot);
+  return w.ok();
+}
+
+}  // namespace
+
+const char* modeName(Mode mode) {
+  const size_t i = static_cast<size_t>(mode);
+  return (i < sizeof(kModeNames) / sizeof(kModeNames[0])) ? kModeNames[i] : "unknown";
+}
+
+const char* presetName(StatusPreset preset) {
+  const size_t i = static_cast<size_t>(preset);
+  return (i < sizeof(kPresetNames) / sizeof(kPresetNames[0])) ? kPresetNames[i] : "unknown";
+}
+
+Status serializeState(const StatusLed& leds, SerialFormat format, SerialOutput* out) {
+  const Status st = checkArgs(leds, format, out);
+  if (!st.ok()) {
+    return st;
+  }
+
+  Writer w(out, format);
+  const uint8_t count = leds.ledCount();
+  w.beginMap(3);
+  w.key("version");
+  w.uint(leds.stateVersion());
+  w.key("displayed");
+  w.uint(leds.displayedVersion());
+  w.key("leds");
+  w.beginArray(count);
+  for (uint8_t i = 0; i < count && w.ok(); ++i) {
+    LedSnapshot snap;
+    if (!leds.getLedSnapshot(i, &snap).ok()) {
+      return Status(Err::INTERNAL_ERROR, i, "snapshot failed");
+    }
+    writeLed(w, i, snap);
+  }
+  w.endArray();
+  w.endMap();
+  return w.finish();
+}
+
+Status serializeChanges(const StatusLed& leds, uint32_t sinceVersion, SerialFormat format,
+                        SerialOutput* out) {
+  const Status st = checkArgs(leds, format, out);
+  if (!st.ok()) {
+    return st;
+  }
+
+  Writer w(out, format);
+  w.beginMap(3);
+  w.key("since");
+  w.uint(sinceVersion);
+  w.key("version");
+  w.uint(leds.stateVersion());
+  w.key("changes");
+  w.beginStream();
+  const Status walked = leds.forEachChangeSince(sinceVersion, &writeChange, &w);
+  if (!walked.ok()) {
+    return walked;
+  }
+  w.endStream();
+  w.endMap();
+  return w.finish();
+}
+
+}  // namespace StatusLed
@@ -0,0 +1,70 @@
+/**
+ * @file rmt.h
+ * @brief Host mock of the legacy RMT driver (ESP-IDF 4.x, driver/rmt.h).
+ *
+ * Not to be combined with the RMT v2 mocks (rmt_types.h) in one build.
+ */
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  RMT_CHANNEL_0 = 0,
+  RMT_CHANNEL_1,
+  RMT_CHANNEL_2,
+  RMT_CHANNEL_3,
+  RMT_CHANNEL_MAX
+} rmt_channel_t;
+
+typedef enum { RMT_IDLE_LEVEL_LOW = 0, RMT_IDLE_LEVEL_HIGH } rmt_idle_level_t;
+
+typedef struct {
+  uint32_t duration0 : 15;
+  uint32_t level0 : 1;
+  uint32_t duration1 : 15;
+  uint32_t level1 : 1;
+} rmt_item32_t;
+
+typedef struct {
+  rmt_idle_level_t idle_level;
+  bool idle_output_en;
+  bool carrier_en;
+  bool loop_en;
+} rmt_tx_config_t;
+
+typedef struct {
+  rmt_channel_t channel;
+  gpio_num_t gpio_num;
+  uint8_t clk_div;
+  uint8_t mem_block_num;
+  rmt_tx_config_t tx_config;
+} rmt_config_t;
+
+#define RMT_DEFAULT_CONFIG_TX(gpio, channel_id) \
+  { (channel_id), (gpio), 80, 1, {RMT_IDLE_LEVEL_LOW, true, false, false} }
+
+typedef void (*rmt_tx_end_fn_t)(rmt_channel_t channel, void* arg);
+
+typedef struct {
+  rmt_tx_end_fn_t function;
+  void* arg;
+} rmt_tx_end_callback_t;
+
+esp_err_t rmt_config(const rmt_config_t* rmt_param);
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t rx_buf_size, int intr_alloc_flags);
+esp_err_t rmt_driver_uninstall(rmt_channel_t channel);
+esp_err_t rmt_wait_tx_done(rmt_channel_t channel, uint32_t wait_time);
+esp_err_t rmt_write_items(rmt_channel_t channel, const rmt_item32_t* rmt_item, int item_num,
+                          bool wait_tx_done);
+esp_err_t rmt_tx_stop(rmt_channel_t channel);
+rmt_tx_end_callback_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file rmt_encoder.h
+ * @brief Host mock of RMT v2 encoders (ESP-IDF 5.x).
+ */
+
+#pragma once
+
+#include "driver/rmt_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+  rmt_symbol_word_t bit0;
+  rmt_symbol_word_t bit1;
+  struct {
+    uint32_t msb_first : 1;
+  } flags;
+} rmt_bytes_encoder_config_t;
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t* config,
+                                rmt_encoder_handle_t* ret_encoder);
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder);
+
+#ifdef __cplusplus
+}
+#endif
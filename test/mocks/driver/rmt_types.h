@@ -0,0 +1,40 @@
+/**
+ * @file rmt_types.h
+ * @brief Host mock of RMT v2 common types (ESP-IDF 5.x).
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rmt_channel_t* rmt_channel_handle_t;
+typedef struct rmt_encoder_t* rmt_encoder_handle_t;
+typedef struct rmt_sync_manager_t* rmt_sync_manager_handle_t;
+
+typedef int rmt_clock_source_t;
+#define RMT_CLK_SRC_DEFAULT 0
+
+typedef union {
+  struct {
+    uint16_t duration0 : 15;
+    uint16_t level0 : 1;
+    uint16_t duration1 : 15;
+    uint16_t level1 : 1;
+  };
+  uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct {
+  size_t num_symbols;
+} rmt_tx_done_event_data_t;
+
+typedef bool (*rmt_tx_done_callback_t)(rmt_channel_handle_t tx_chan,
+                                       const rmt_tx_done_event_data_t* edata, void* user_ctx);
+
+#ifdef __cplusplus
+}
+#endif
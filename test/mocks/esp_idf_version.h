@@ -0,0 +1,10 @@
+/**
+ * @file esp_idf_version.h
+ * @brief Host mock of the ESP-IDF version header.
+ */
+
+#pragma once
+
+#ifndef ESP_IDF_VERSION_MAJOR
+#define ESP_IDF_VERSION_MAJOR 5
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file esp_timer.h
+ * @brief Host mock of esp_timer (clock driven by idfmock::setTimeUs()).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
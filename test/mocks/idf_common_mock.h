@@ -0,0 +1,49 @@
+/**
+ * @file idf_common_mock.h
+ * @brief Host implementation of the ESP-IDF APIs shared by both RMT backends
+ *        (esp_timer, GPIO, partitions).
+ *
+ * Included by idf_mock.h and idf_legacy_mock.h; not meant to be used directly.
+ */
+
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+
+namespace idfmock {
+
+struct CommonState {
+  int64_t nowUs = 0;
+};
+
+inline CommonState& commonState() {
+  static CommonState s;
+  return s;
+}
+
+/// @brief Set the esp_timer clock.
+inline void setTimeUs(int64_t nowUs) { commonState().nowUs = nowUs; }
+
+}  // namespace idfmock
+
+extern "C" {
+
+int64_t esp_timer_get_time(void) { return idfmock::commonState().nowUs; }
+
+esp_err_t gpio_reset_pin(gpio_num_t) { return ESP_OK; }
+esp_err_t gpio_set_direction(gpio_num_t, gpio_mode_t) { return ESP_OK; }
+esp_err_t gpio_set_level(gpio_num_t, uint32_t) { return ESP_OK; }
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t,
+                                                const char*) {
+  return nullptr;
+}
+esp_err_t esp_partition_mmap(const esp_partition_t*, size_t, size_t, esp_partition_mmap_memory_t,
+                             const void**, esp_partition_mmap_handle_t*) {
+  return ESP_ERR_NOT_FOUND;
+}
+void esp_partition_munmap(esp_partition_mmap_handle_t) {}
+
+}  // extern "C"
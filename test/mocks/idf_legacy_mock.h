@@ -0,0 +1,210 @@
+/**
+ * @file idf_legacy_mock.h
+ * @brief Host implementation of the mocked legacy RMT driver (ESP-IDF 4.x).
+ *
+ * Include from exactly one translation unit (the test runner), in builds of
+ * the legacy backend only. Channels are configured, installed and busy
+ * independently; like the driver, the mock keeps one tx-end callback for all
+ * of them. It fires from completeTx(), which stands in for the transmit-end
+ * interrupt. rmt_write_items() decodes the items back into bytes so tests can
+ * compare what the LEDs would receive.
+ */
+
+#pragma once
+
+#include <string.h>
+
+#include "driver/rmt.h"
+#include "idf_common_mock.h"
+
+namespace idfmock {
+
+static constexpr size_t kMaxWireBytes = 128;
+static constexpr size_t kMaxChannels = RMT_CHANNEL_MAX;
+
+struct Channel {
+  bool configured = false;
+  bool installed = false;
+  bool busy = false;
+  bool hung = false;  ///< Transmissions never finish; cleared only by rmt_driver_uninstall()
+};
+
+struct State {
+  Channel channels[kMaxChannels]{};
+  rmt_tx_end_callback_t txEnd{};
+  uint32_t writes = 0;
+  uint32_t waitCalls = 0;         ///< rmt_wait_tx_done() calls (polling)
+  uint32_t stops = 0;
+  uint32_t installs = 0;          ///< Successful rmt_driver_install() calls
+  uint32_t blockedWrites = 0;     ///< Writes that would block forever on the tx semaphore
+  esp_err_t nextWriteError = ESP_OK;
+  esp_err_t nextInstallError = ESP_OK;
+  bool dropTxEnd = false;         ///< completeTx() finishes without calling the tx-end callback
+  bool itemsValid = true;         ///< Every data item of the last write had the WS2812 shape
+  size_t wireBytes = 0;           ///< Bytes decoded from the last write
+  uint8_t wire[kMaxWireBytes]{};
+};
+
+inline State& state() {
+  static State s;
+  return s;
+}
+
+/// @brief Reset all mock state (call from setUp()).
+inline void reset() {
+  state() = State();
+  commonState() = CommonState();
+}
+
+inline Channel* channel(rmt_channel_t channel) {
+  return (channel >= RMT_CHANNEL_0 && channel < RMT_CHANNEL_MAX) ? &state().channels[channel]
+                                                                 : nullptr;
+}
+
+/// @brief Finish a channel's in-flight transmission and run the tx-end callback.
+inline void completeTx(rmt_channel_t index = RMT_CHANNEL_0) {
+  State& s = state();
+  Channel* ch = channel(index);
+  if (ch == nullptr || !ch->busy || ch->hung) {
+    return;
+  }
+  ch->busy = false;
+  if (s.txEnd.function != nullptr && !s.dropTxEnd) {
+    s.txEnd.function(index, s.txEnd.arg);
+  }
+}
+
+}  // namespace idfmock
+
+extern "C" {
+
+esp_err_t rmt_config(const rmt_config_t* rmt_param) {
+  idfmock::Channel* ch = (rmt_param != nullptr) ? idfmock::channel(rmt_param->channel) : nullptr;
+  if (ch == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  ch->configured = true;
+  return ESP_OK;
+}
+
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t, int) {
+  idfmock::State& s = idfmock::state();
+  if (s.nextInstallError != ESP_OK) {
+    const esp_err_t err = s.nextInstallError;
+    s.nextInstallError = ESP_OK;
+    return err;
+  }
+  idfmock::Channel* ch = idfmock::channel(channel);
+  if (ch == nullptr || !ch->configured) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (ch->installed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  ch->installed = true;
+  ++s.installs;
+  return ESP_OK;
+}
+
+esp_err_t rmt_driver_uninstall(rmt_channel_t channel) {
+  idfmock::Channel* ch = idfmock::channel(channel);
+  if (ch == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  ch->installed = false;
+  ch->busy = false;
+  ch->hung = false;
+  return ESP_OK;
+}
+
+esp_err_t rmt_wait_tx_done(rmt_channel_t channel, uint32_t wait_time) {
+  ++idfmock::state().waitCalls;
+  idfmock::Channel* ch = idfmock::channel(channel);
+  if (ch == nullptr || !ch->installed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (ch->busy && (ch->hung || wait_time == 0)) {
+    return ESP_ERR_TIMEOUT;
+  }
+  idfmock::completeTx(channel);
+  return ESP_OK;
+}
+
+esp_err_t rmt_write_items(rmt_channel_t channel, const rmt_item32_t* rmt_item, int item_num,
+                          bool wait_tx_done) {
+  idfmock::State& s = idfmock::state();
+  if (s.nextWriteError != ESP_OK) {
+    const esp_err_t err = s.nextWriteError;
+    s.nextWriteError = ESP_OK;
+    return err;
+  }
+  idfmock::Channel* ch = idfmock::channel(channel);
+  if (ch == nullptr || !ch->installed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (rmt_item == nullptr || item_num <= 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (ch->busy) {
+    idfmock::completeTx(channel);  // The driver blocks until the previous frame is done
+  }
+  if (ch->busy) {
+    ++s.blockedWrites;  // The tx semaphore is never given back: the driver hangs here
+    return ESP_ERR_TIMEOUT;
+  }
+
+  // MSB-first bits; a data bit is a high pulse followed by a low one, a 1
+  // holding the line high longer than it is low. Stop at the reset item.
+  s.itemsValid = true;
+  s.wireBytes = 0;
+  uint8_t value = 0;
+  uint8_t bits = 0;
+  for (int i = 0; i < item_num; ++i) {
+    const rmt_item32_t& item = rmt_item[i];
+    if (item.level0 == 0) {
+      break;
+    }
+    if (item.level1 != 0 || item.duration0 == 0 || item.duration1 == 0) {
+      s.itemsValid = false;
+    }
+    value = static_cast<uint8_t>((value << 1) | (item.duration0 > item.duration1 ? 1u : 0u));
+    if (++bits == 8) {
+      if (s.wireBytes < idfmock::kMaxWireBytes) {
+        s.wire[s.wireBytes++] = value;
+      }
+      value = 0;
+      bits = 0;
+    }
+  }
+  if (bits != 0) {
+    s.itemsValid = false;
+  }
+
+  ch->busy = true;
+  ++s.writes;
+  if (wait_tx_done) {
+    idfmock::completeTx(channel);
+  }
+  return ESP_OK;
+}
+
+esp_err_t rmt_tx_stop(rmt_channel_t channel) {
+  idfmock::Channel* ch = idfmock::channel(channel);
+  if (ch == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  ++idfmock::state().stops;
+  // The transmitter halts, but only the tx-end interrupt releases the driver's
+  // tx semaphore: rmt_wait_tx_done() keeps timing out.
+  return ESP_OK;
+}
+
+rmt_tx_end_callback_t rmt_register_tx_end_callback(rmt_tx_end_fn_t function, void* arg) {
+  idfmock::State& s = idfmock::state();
+  const rmt_tx_end_callback_t previous = s.txEnd;
+  s.txEnd.function = function;
+  s.txEnd.arg = arg;
+  return previous;
+}
+
+}  // extern "C"
@@ -0,0 +1,402 @@
+/**
+ * @file idf_mock.h
+ * @brief Host implementation of the mocked ESP-IDF APIs used by the backends.
+ *
+ * Include from exactly one translation unit (the test runner). The RMT v2
+ * mock runs the bytes encoder on every rmt_transmit(), decodes the resulting
+ * symbols back into bytes, and expands loop_count so tests can compare what
+ * the LEDs would receive regardless of how the backend chose to send it.
+ *
+ * Up to kMaxChannels TX channels exist. Channels grouped by a sync manager
+ * hold their transaction until every channel of the group has one, then all
+ * start at once (same startSeq).
+ */
+
+#pragma once
+
+#include <string.h>
+
+#include "driver/rmt_encoder.h"
+#include "driver/rmt_tx.h"
+#include "idf_common_mock.h"
+
+namespace idfmock {
+
+static constexpr size_t kMaxWireBytes = 128;
+static constexpr size_t kMaxSymbols = 512;
+static constexpr size_t kMaxChannels = 4;
+
+/// @brief One rmt_transmit() call as seen on the wire.
+struct Transmission {
+  size_t payloadBytes = 0;    ///< Bytes handed to rmt_transmit()
+  int loopCount = 0;          ///< rmt_transmit_config_t::loop_count
+  size_t encodedSymbols = 0;  ///< Symbols produced by one encoder pass
+  bool symbolsValid = true;   ///< Every symbol matched bit0 or bit1
+  size_t wireBytes = 0;       ///< Bytes decoded from the wire (loops expanded)
+  uint8_t wire[kMaxWireBytes]{};
+};
+
+struct Channel {
+  bool created = false;
+  bool enabled = false;
+  bool busy = false;         ///< Transaction queued or running
+  bool waiting = false;      ///< Queued, held by the sync manager
+  bool inSync = false;       ///< Member of the sync group
+  gpio_num_t gpio = GPIO_NUM_NC;
+  size_t memBlockSymbols = 0;
+  rmt_tx_done_callback_t onDone = nullptr;
+  void* doneCtx = nullptr;
+  uint32_t queuedSeq = 0;    ///< State::transmits when the transaction was queued
+  uint32_t startSeq = 0;     ///< State::transmits when it started on the wire
+  Transmission last{};
+};
+
+struct Encoder {
+  bool created = false;
+  rmt_bytes_encoder_config_t bytes{};
+};
+
+struct State {
+  Channel channels[kMaxChannels]{};
+  Encoder encoders[kMaxChannels]{};
+  bool syncCreated = false;
+  uint8_t syncMask = 0;             ///< Channels in the group
+  uint8_t syncQueued = 0;           ///< Group members holding a transaction
+  uint32_t syncStarts = 0;          ///< Simultaneous group starts
+  uint32_t syncResets = 0;
+  esp_err_t syncError = ESP_OK;     ///< rmt_new_sync_manager() result
+  uint32_t transmits = 0;
+  uint32_t disables = 0;
+  uint32_t channelsCreated = 0;
+  esp_err_t nextTransmitError = ESP_OK;
+  uint32_t transmitErrorAfter = 0;  ///< Successful transmits before nextTransmitError applies
+  bool dropDoneCallback = false;  ///< completeTx() finishes without firing on_trans_done
+  bool hung = false;              ///< Transmissions never finish until the channel is disabled
+  bool enableFails = false;       ///< rmt_enable() returns ESP_FAIL
+  Transmission last{};            ///< Most recent transmission on any channel
+};
+
+inline State& state() {
+  static State s;
+  return s;
+}
+
+inline rmt_channel_handle_t channelHandle(size_t index) {
+  return reinterpret_cast<rmt_channel_handle_t>(&state().channels[index]);
+}
+
+inline size_t channelIndex(rmt_channel_handle_t handle) {
+  for (size_t i = 0; i < kMaxChannels; ++i) {
+    if (handle == channelHandle(i)) {
+      return i;
+    }
+  }
+  return kMaxChannels;
+}
+
+/// @brief Reset all mock state (call from setUp()).
+inline void reset() {
+  state() = State();
+  commonState() = CommonState();
+}
+
+/// @brief True while any channel has a transaction queued or running.
+inline bool busy() {
+  for (const Channel& ch : state().channels) {
+    if (ch.busy) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief Finish one channel's running transmission and fire on_trans_done.
+inline void completeChannel(size_t index) {
+  State& s = state();
+  Channel& ch = s.channels[index];
+  if (!ch.busy || ch.waiting) {
+    return;
+  }
+  ch.busy = false;
+  if (ch.onDone != nullptr && !s.dropDoneCallback) {
+    rmt_tx_done_event_data_t data{};
+    data.num_symbols = ch.last.encodedSymbols;
+    ch.onDone(channelHandle(index), &data, ch.doneCtx);
+  }
+}
+
+/// @brief Finish every running transmission.
+inline void completeTx() {
+  for (size_t i = 0; i < kMaxChannels; ++i) {
+    completeChannel(i);
+  }
+}
+
+inline bool symbolEquals(const rmt_symbol_word_t& a, const rmt_symbol_word_t& b) {
+  return a.duration0 == b.duration0 && a.level0 == b.level0 && a.duration1 == b.duration1 &&
+         a.level1 == b.level1;
+}
+
+}  // namespace idfmock
+
+extern "C" {
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t* config,
+                             rmt_channel_handle_t* ret_chan) {
+  idfmock::State& s = idfmock::state();
+  if (config == nullptr || ret_chan == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  for (size_t i = 0; i < idfmock::kMaxChannels; ++i) {
+    idfmock::Channel& ch = s.channels[i];
+    if (!ch.created) {
+      ch = idfmock::Channel();
+      ch.created = true;
+      ch.gpio = config->gpio_num;
+      ch.memBlockSymbols = config->mem_block_symbols;
+      ++s.channelsCreated;
+      *ret_chan = idfmock::channelHandle(i);
+      return ESP_OK;
+    }
+  }
+  return ESP_ERR_NOT_FOUND;  // All TX channels in use
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel) {
+  const size_t i = idfmock::channelIndex(channel);
+  if (i == idfmock::kMaxChannels || !idfmock::state().channels[i].created) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (idfmock::state().channels[i].inSync) {
+    return ESP_ERR_INVALID_STATE;  // Delete the sync manager first
+  }
+  idfmock::state().channels[i] = idfmock::Channel();
+  return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel) {
+  idfmock::State& s = idfmock::state();
+  const size_t i = idfmock::channelIndex(channel);
+  if (i == idfmock::kMaxChannels) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (s.enableFails) {
+    return ESP_FAIL;
+  }
+  s.channels[i].enabled = true;
+  return ESP_OK;
+}
+
+esp_err_t rmt_disable(rmt_channel_handle_t channel) {
+  idfmock::State& s = idfmock::state();
+  const size_t i = idfmock::channelIndex(channel);
+  if (i == idfmock::kMaxChannels) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  idfmock::Channel& ch = s.channels[i];
+  ch.enabled = false;
+  ch.busy = false;  // Aborts without a done callback, like the driver
+  ch.waiting = false;
+  s.syncQueued = static_cast<uint8_t>(s.syncQueued & ~(1u << i));
+  s.hung = false;
+  ++s.disables;
+  return ESP_OK;
+}
+
+esp_err_t rmt_tx_register_event_callbacks(rmt_channel_handle_t channel,
+                                          const rmt_tx_event_callbacks_t* cbs, void* user_data) {
+  const size_t i = idfmock::channelIndex(channel);
+  if (i == idfmock::kMaxChannels) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  idfmock::Channel& ch = idfmock::state().channels[i];
+  ch.onDone = (cbs != nullptr) ? cbs->on_trans_done : nullptr;
+  ch.doneCtx = user_data;
+  return ESP_OK;
+}
+
+esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t* config,
+                                rmt_encoder_handle_t* ret_encoder) {
+  if (config == nullptr || ret_encoder == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  for (idfmock::Encoder& enc : idfmock::state().encoders) {
+    if (!enc.created) {
+      enc.created = true;
+      enc.bytes = *config;
+      *ret_encoder = reinterpret_cast<rmt_encoder_handle_t>(&enc);
+      return ESP_OK;
+    }
+  }
+  return ESP_ERR_NO_MEM;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) {
+  if (encoder == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  reinterpret_cast<idfmock::Encoder*>(encoder)->created = false;
+  return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t channel, rmt_encoder_handle_t encoder,
+                       const void* payload, size_t payload_bytes,
+                       const rmt_transmit_config_t* config) {
+  idfmock::State& s = idfmock::state();
+  const size_t index = idfmock::channelIndex(channel);
+  if (index == idfmock::kMaxChannels || encoder == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (s.nextTransmitError != ESP_OK) {
+    if (s.transmitErrorAfter == 0) {
+      const esp_err_t err = s.nextTransmitError;
+      s.nextTransmitError = ESP_OK;
+      return err;
+    }
+    --s.transmitErrorAfter;
+  }
+  idfmock::Channel& ch = s.channels[index];
+  if (!ch.enabled) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (ch.busy) {
+    return ESP_ERR_TIMEOUT;
+  }
+  if (payload == nullptr || config == nullptr || payload_bytes * 8 > idfmock::kMaxSymbols) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  // Bytes encoder: one symbol per bit.
+  const rmt_bytes_encoder_config_t& bytesCfg = reinterpret_cast<idfmock::Encoder*>(encoder)->bytes;
+  rmt_symbol_word_t symbols[idfmock::kMaxSymbols];
+  const uint8_t* bytes = static_cast<const uint8_t*>(payload);
+  size_t symbolCount = 0;
+  for (size_t i = 0; i < payload_bytes; ++i) {
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      const uint8_t shift = bytesCfg.flags.msb_first ? static_cast<uint8_t>(7 - bit) : bit;
+      symbols[symbolCount++] = ((bytes[i] >> shift) & 1u) ? bytesCfg.bit1 : bytesCfg.bit0;
+    }
+  }
+  // Looped data must fit the channel memory block (plus the end marker).
+  if (config->loop_count != 0 && symbolCount + 1 > ch.memBlockSymbols) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  idfmock::Transmission tx;
+  tx.payloadBytes = payload_bytes;
+  tx.loopCount = config->loop_count;
+  tx.encodedSymbols = symbolCount;
+  const int rounds = (config->loop_count > 0) ? config->loop_count : 1;
+  for (int round = 0; round < rounds; ++round) {
+    for (size_t i = 0; i + 8 <= symbolCount && tx.wireBytes < idfmock::kMaxWireBytes; i += 8) {
+      uint8_t value = 0;
+      for (uint8_t bit = 0; bit < 8; ++bit) {
+        const rmt_symbol_word_t& sym = symbols[i + bit];
+        const bool one = idfmock::symbolEquals(sym, bytesCfg.bit1);
+        if (!one && !idfmock::symbolEquals(sym, bytesCfg.bit0)) {
+          tx.symbolsValid = false;
+        }
+        const uint8_t shift = bytesCfg.flags.msb_first ? static_cast<uint8_t>(7 - bit) : bit;
+        value = static_cast<uint8_t>(value | ((one ? 1u : 0u) << shift));
+      }
+      tx.wire[tx.wireBytes++] = value;
+    }
+  }
+  ch.last = tx;
+  s.last = tx;
+  ch.busy = true;
+  ++s.transmits;
+  ch.queuedSeq = s.transmits;
+
+  if (!ch.inSync) {
+    ch.startSeq = s.transmits;
+    return ESP_OK;
+  }
+  // Held until the whole group has a transaction, then started together.
+  ch.waiting = true;
+  s.syncQueued = static_cast<uint8_t>(s.syncQueued | (1u << index));
+  if (s.syncQueued == s.syncMask) {
+    for (size_t i = 0; i < idfmock::kMaxChannels; ++i) {
+      if ((s.syncMask & (1u << i)) != 0) {
+        s.channels[i].waiting = false;
+        s.channels[i].startSeq = s.transmits;
+      }
+    }
+    s.syncQueued = 0;
+    ++s.syncStarts;
+  }
+  return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t channel, int) {
+  const size_t i = idfmock::channelIndex(channel);
+  if (i == idfmock::kMaxChannels) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (idfmock::state().hung || idfmock::state().channels[i].waiting) {
+    return ESP_ERR_TIMEOUT;
+  }
+  idfmock::completeChannel(i);
+  return ESP_OK;
+}
+
+esp_err_t rmt_new_sync_manager(const rmt_sync_manager_config_t* config,
+                               rmt_sync_manager_handle_t* ret_synchro) {
+  idfmock::State& s = idfmock::state();
+  if (config == nullptr || ret_synchro == nullptr || config->tx_channel_array == nullptr ||
+      config->array_size < 2 || config->array_size > idfmock::kMaxChannels) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (s.syncError != ESP_OK) {
+    return s.syncError;
+  }
+  if (s.syncCreated) {
+    return ESP_ERR_NOT_FOUND;  // One group in this mock
+  }
+  uint8_t mask = 0;
+  for (size_t n = 0; n < config->array_size; ++n) {
+    const size_t i = idfmock::channelIndex(config->tx_channel_array[n]);
+    if (i == idfmock::kMaxChannels || (mask & (1u << i)) != 0) {
+      return ESP_ERR_INVALID_ARG;
+    }
+    const idfmock::Channel& ch = s.channels[i];
+    if (!ch.created || !ch.enabled || ch.busy || ch.inSync) {
+      return ESP_ERR_INVALID_STATE;  // Channels must be enabled and idle
+    }
+    mask = static_cast<uint8_t>(mask | (1u << i));
+  }
+  for (size_t i = 0; i < idfmock::kMaxChannels; ++i) {
+    s.channels[i].inSync = (mask & (1u << i)) != 0;
+  }
+  s.syncCreated = true;
+  s.syncMask = mask;
+  s.syncQueued = 0;
+  *ret_synchro = reinterpret_cast<rmt_sync_manager_handle_t>(&s.syncMask);
+  return ESP_OK;
+}
+
+esp_err_t rmt_del_sync_manager(rmt_sync_manager_handle_t) {
+  idfmock::State& s = idfmock::state();
+  if (!s.syncCreated) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  for (idfmock::Channel& ch : s.channels) {
+    ch.inSync = false;
+    ch.waiting = false;
+  }
+  s.syncCreated = false;
+  s.syncMask = 0;
+  s.syncQueued = 0;
+  return ESP_OK;
+}
+
+esp_err_t rmt_sync_reset(rmt_sync_manager_handle_t) {
+  idfmock::State& s = idfmock::state();
+  if (!s.syncCreated || s.syncQueued != 0) {
+    return ESP_ERR_INVALID_STATE;  // Queued members must be disabled first
+  }
+  ++s.syncResets;
+  return ESP_OK;
+}
+
+}  // extern "C"
@@ -0,0 +1,22 @@
+/**
+ * @file soc_caps.h
+ * @brief Host mock of SoC capabilities (ESP32-S3-like RMT).
+ */
+
+#pragma once
+
+#ifndef SOC_RMT_SUPPORT_TX_LOOP_COUNT
+#define SOC_RMT_SUPPORT_TX_LOOP_COUNT 1
+#endif
+
+#ifndef SOC_RMT_SUPPORT_TX_LOOP_AUTO_STOP
+#define SOC_RMT_SUPPORT_TX_LOOP_AUTO_STOP 1
+#endif
+
+#ifndef SOC_RMT_SUPPORT_TX_SYNCHRO
+#define SOC_RMT_SUPPORT_TX_SYNCHRO 1
+#endif
+
+#ifndef SOC_RMT_MEM_WORDS_PER_CHANNEL
+#define SOC_RMT_MEM_WORDS_PER_CHANNEL 48
+#endif
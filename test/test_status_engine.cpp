@@ -1,6 +1,25 @@
 #include <unity.h>
 
+#include <chrono>
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StatusLed/ExtPool.h"
+#include "StatusLed/Pack.h"
+#include "StatusLed/Serializer.h"
 #include "StatusLed/StatusLed.h"
+#if STATUSLED_BACKEND_NULL
+#include "StatusLedBackendSim.h"
+#endif
+#if STATUSLED_BACKEND_IDF5_WS2812
+#include "mocks/idf_mock.h"
+#elif STATUSLED_BACKEND_IDF_WS2812
+#include "mocks/idf_legacy_mock.h"
+#endif
 
 static StatusLed::Config make_config() {
   StatusLed::Config cfg;
@@ -12,6 +31,14 @@ static StatusLed::Config make_config() {
   return cfg;
 }
 
+// FrameDoneCallback counting completions into a uint32_t.
+static bool count_frame_done(void* user) {
+  ++*static_cast<uint32_t*>(user);
+  return false;
+}
+
+#if STATUSLED_BACKEND_NULL
+
 static void test_blink_fast_toggles() {
   StatusLed::StatusLed leds;
   const StatusLed::Status st = leds.begin(make_config());
@@ -581,11 +608,2332 @@ static void test_set_all_color_applies_to_all() {
   leds.end();
 }
 
-void setUp() {}
+// Test pack: pattern 0 = {100ms @255, 300ms @0 alt}, track 0 = ramp 0->200 over 100ms,
+// hold 200 until 300ms (non-looping), palette 0 = {red, blue}, presets: pattern, track, Solid.
+struct TestPack {
+  uint32_t words[64];
+  size_t size;
+};
+
+static uint32_t test_crc32(const uint8_t* data, size_t len) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1u) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+    }
+  }
+  return ~crc;
+}
+
+static void build_test_pack(TestPack* pack) {
+  memset(pack, 0, sizeof(*pack));
+  uint8_t* base = reinterpret_cast<uint8_t*>(pack->words);
+  StatusLed::PackHeader* h = reinterpret_cast<StatusLed::PackHeader*>(base);
+  uint32_t offset = sizeof(StatusLed::PackHeader);
+
+  const StatusLed::PackStep steps[] = {{100, 255, 0}, {300, 0, StatusLed::kPackStepUseAlt}};
+  const StatusLed::PackPattern patterns[] = {{0, 2}};
+  const StatusLed::PackKeyframe keys[] = {{0, 0, 0}, {100, 200, StatusLed::kPackKeyHold}, {300, 200, 0}};
+  const StatusLed::PackTrack tracks[] = {{0, 3, 300, 0, 0}};
+  const StatusLed::PackColor colors[] = {{255, 0, 0, 0}, {0, 0, 255, 0}};
+  const StatusLed::PackPalette palettes[] = {{0, 2}};
+  const StatusLed::PackPreset presets[] = {
+      {static_cast<uint8_t>(StatusLed::PackPresetKind::Pattern), 0, 0, 0, 0, 1},
+      {static_cast<uint8_t>(StatusLed::PackPresetKind::Track), 0, 0, 0, 1, 0},
+      {static_cast<uint8_t>(StatusLed::PackPresetKind::BuiltinMode), 0,
+       static_cast<uint16_t>(StatusLed::Mode::Solid), 0, 1, 1},
+  };
+
+#define PUT_TABLE(field, arr)                                  \
+  h->field.offset = offset;                                    \
+  h->field.count = sizeof(arr) / sizeof(arr[0]);               \
+  memcpy(base + offset, arr, sizeof(arr));                     \
+  offset += static_cast<uint32_t>(sizeof(arr));
+  PUT_TABLE(steps, steps)
+  PUT_TABLE(patterns, patterns)
+  PUT_TABLE(keyframes, keys)
+  PUT_TABLE(tracks, tracks)
+  PUT_TABLE(colors, colors)
+  PUT_TABLE(palettes, palettes)
+  PUT_TABLE(presets, presets)
+#undef PUT_TABLE
+
+  h->magic = StatusLed::kPackMagic;
+  h->version = StatusLed::kPackFormatVersion;
+  h->headerSize = sizeof(StatusLed::PackHeader);
+  h->totalSize = offset;
+  h->crc32 = test_crc32(base + h->headerSize, h->totalSize - h->headerSize);
+  pack->size = offset;
+}
+
+static void test_pack_validation_rejects_corruption() {
+  TestPack pack;
+  build_test_pack(&pack);
+  StatusLed::PackView view;
+  TEST_ASSERT_TRUE(StatusLed::PackView::open(pack.words, pack.size, &view).ok());
+  TEST_ASSERT_TRUE(view.valid());
+  TEST_ASSERT_EQUAL_UINT32(3, view.presetCount());
+
+  TEST_ASSERT_FALSE(StatusLed::PackView::open(pack.words, pack.size - 4, &view).ok());
+  TEST_ASSERT_FALSE(view.valid());
+
+  // Flip a payload byte: CRC must catch it.
+  reinterpret_cast<uint8_t*>(pack.words)[sizeof(StatusLed::PackHeader)] ^= 0x01;
+  TEST_ASSERT_FALSE(StatusLed::PackView::open(pack.words, pack.size, &view).ok());
+
+  // Valid CRC but dangling pattern reference.
+  build_test_pack(&pack);
+  uint8_t* base = reinterpret_cast<uint8_t*>(pack.words);
+  StatusLed::PackHeader* h = reinterpret_cast<StatusLed::PackHeader*>(base);
+  StatusLed::PackPattern* pattern = reinterpret_cast<StatusLed::PackPattern*>(base + h->patterns.offset);
+  pattern->stepCount = 5;
+  h->crc32 = test_crc32(base + h->headerSize, h->totalSize - h->headerSize);
+  const StatusLed::Status st = StatusLed::PackView::open(pack.words, pack.size, &view);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG), static_cast<uint16_t>(st.code));
+}
+
+static void test_pack_pattern_plays_steps_in_place() {
+  TestPack pack;
+  build_test_pack(&pack);
+  StatusLed::PackView view;
+  TEST_ASSERT_TRUE(StatusLed::PackView::open(pack.words, pack.size, &view).ok());
+
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_EQUAL_UINT16(
+      static_cast<uint16_t>(StatusLed::Err::NOT_INITIALIZED),
+      static_cast<uint16_t>(leds.setPackPattern(0, 0).code));
+  TEST_ASSERT_TRUE(leds.attachPack(view).ok());
+  TEST_ASSERT_FALSE(leds.setPackPattern(0, 1).ok());
+  TEST_ASSERT_TRUE(leds.setPackPreset(0, 0).ok());
+
+  StatusLed::LedSnapshot snap;
+  leds.tick(0);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::PackPattern), static_cast<uint8_t>(snap.mode));
+  TEST_ASSERT_EQUAL_UINT8(255, snap.intensity);
+  TEST_ASSERT_EQUAL_UINT8(255, snap.color.r);
+  TEST_ASSERT_EQUAL_UINT8(255, snap.altColor.b);
+
+  leds.tick(101);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(0, snap.intensity);
+
+  leds.tick(401);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(255, snap.intensity);
+
+  leds.detachPack();
+  leds.tick(402);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::Off), static_cast<uint8_t>(snap.mode));
+
+  leds.end();
+}
+
+static void test_pack_track_interpolates_and_holds() {
+  TestPack pack;
+  build_test_pack(&pack);
+  StatusLed::PackView view;
+  TEST_ASSERT_TRUE(StatusLed::PackView::open(pack.words, pack.size, &view).ok());
+
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.attachPack(view).ok());
+  TEST_ASSERT_TRUE(leds.setPackPreset(0, 1).ok());
+
+  StatusLed::LedSnapshot snap;
+  leds.tick(0);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(0, snap.intensity);
+  TEST_ASSERT_EQUAL_UINT8(255, snap.color.b);
+
+  leds.tick(60);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(120, snap.intensity);
+
+  leds.tick(200);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(200, snap.intensity);
+
+  leds.tick(400);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(200, snap.intensity);
+
+  TEST_ASSERT_TRUE(leds.setPackPreset(0, 2).ok());
+  leds.tick(410);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::Solid), static_cast<uint8_t>(snap.mode));
+  TEST_ASSERT_EQUAL_UINT8(255, snap.intensity);
+
+  leds.end();
+}
+
+static void test_pack_file_mapping_roundtrip() {
+  TestPack pack;
+  build_test_pack(&pack);
+  char path[] = "/tmp/statusled_pack_XXXXXX";
+  FILE* f = nullptr;
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = mkstemp(path);
+  TEST_ASSERT_TRUE(fd >= 0);
+  f = fdopen(fd, "wb");
+#endif
+  if (f == nullptr) {
+    TEST_MESSAGE("file mapping not supported on this host");
+    return;
+  }
+  TEST_ASSERT_EQUAL_UINT32(pack.size, fwrite(pack.words, 1, pack.size, f));
+  fclose(f);
+
+  StatusLed::PackMapping mapping;
+  TEST_ASSERT_TRUE(StatusLed::mapPackFile(path, &mapping).ok());
+  StatusLed::PackView view;
+  TEST_ASSERT_TRUE(StatusLed::PackView::open(mapping.data, mapping.size, &view).ok());
+  TEST_ASSERT_EQUAL_UINT32(1, view.patternCount());
+  StatusLed::unmapPack(&mapping);
+  TEST_ASSERT_NULL(mapping.data);
+  remove(path);
+}
+
+struct ChangeLog {
+  uint8_t count = 0;
+  uint8_t limit = 4;
+  uint8_t indices[4]{};
+};
+
+static bool record_change(const StatusLed::LedChange& change, void* user) {
+  ChangeLog* log = static_cast<ChangeLog*>(user);
+  log->indices[log->count++] = change.index;
+  return log->count < log->limit;
+}
+
+static void test_change_feed_reports_only_changed_leds() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 4;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+
+  StatusLed::LedChange changes[4];
+  uint8_t count = 0;
+  TEST_ASSERT_TRUE(leds.getChangesSince(0, changes, 4, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(4, count);
+
+  uint32_t seen = leds.stateVersion();
+  leds.setPreset(2, StatusLed::StatusPreset::Busy);
+  leds.setBrightness(0, 100);
+  leds.setBrightness(0, 100);  // Same value: no new change
+  for (uint32_t t = 0; t < 500; t += 10) {
+    leds.tick(t);  // Animation progress is not a logical change
+  }
+
+  TEST_ASSERT_TRUE(leds.getChangesSince(seen, changes, 4, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(2, count);
+  TEST_ASSERT_EQUAL_UINT8(2, changes[0].index);
+  TEST_ASSERT_EQUAL_UINT8(0, changes[1].index);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::StatusPreset::Busy),
+                          static_cast<uint8_t>(changes[0].snapshot.preset));
+  TEST_ASSERT_EQUAL_UINT32(leds.stateVersion(), changes[1].version);
+
+  seen = leds.stateVersion();
+  TEST_ASSERT_TRUE(leds.getChangesSince(seen, changes, 4, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(0, count);
+
+  // Truncated reads resume from the last returned version.
+  leds.setColor(3, StatusLed::RgbColor(1, 2, 3));
+  leds.setColor(1, StatusLed::RgbColor(1, 2, 3));
+  leds.setColor(3, StatusLed::RgbColor(4, 5, 6));
+  TEST_ASSERT_TRUE(leds.getChangesSince(seen, changes, 1, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(1, count);
+  TEST_ASSERT_EQUAL_UINT8(1, changes[0].index);
+  TEST_ASSERT_TRUE(leds.getChangesSince(changes[0].version, changes, 1, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(1, count);
+  TEST_ASSERT_EQUAL_UINT8(3, changes[0].index);
+  TEST_ASSERT_EQUAL_UINT8(4, changes[0].snapshot.color.r);
+
+  // The visitor walks the same feed once, oldest first, and can stop early.
+  ChangeLog log;
+  TEST_ASSERT_TRUE(leds.forEachChangeSince(seen, &record_change, &log).ok());
+  TEST_ASSERT_EQUAL_UINT8(2, log.count);
+  TEST_ASSERT_EQUAL_UINT8(1, log.indices[0]);
+  TEST_ASSERT_EQUAL_UINT8(3, log.indices[1]);
+  log = ChangeLog();
+  log.limit = 1;
+  TEST_ASSERT_TRUE(leds.forEachChangeSince(0, &record_change, &log).ok());
+  TEST_ASSERT_EQUAL_UINT8(1, log.count);
+  TEST_ASSERT_EQUAL_UINT8(2, log.indices[0]);
+  TEST_ASSERT_FALSE(leds.forEachChangeSince(0, nullptr, nullptr).ok());
+
+  leds.end();
+}
+
+static void test_change_feed_tracks_temporary_presets() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  leds.setPreset(0, StatusLed::StatusPreset::Ready);
+  leds.tick(0);
+
+  const uint32_t before = leds.stateVersion();
+  leds.setTemporaryPreset(0, StatusLed::StatusPreset::Error, 100);
+  leds.tick(10);
+  TEST_ASSERT_GREATER_THAN_UINT32(before, leds.stateVersion());
+
+  const uint32_t active = leds.stateVersion();
+  leds.tick(50);
+  TEST_ASSERT_EQUAL_UINT32(active, leds.stateVersion());
+  leds.tick(120);
+  TEST_ASSERT_GREATER_THAN_UINT32(active, leds.stateVersion());
+
+  StatusLed::LedChange change;
+  uint8_t count = 0;
+  TEST_ASSERT_TRUE(leds.getChangesSince(active, &change, 1, &count).ok());
+  TEST_ASSERT_EQUAL_UINT8(1, count);
+  TEST_ASSERT_FALSE(change.snapshot.tempActive);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::StatusPreset::Ready),
+                          static_cast<uint8_t>(change.snapshot.preset));
+
+  leds.end();
+}
+
+// Drive engine and simulated wire from one microsecond clock.
+static void tick_us(StatusLed::StatusLed& leds, uint32_t now_us) {
+  StatusLed::sim::setTimeUs(now_us);
+  leds.tick(now_us / 1000u);
+}
+
+// Change-to-wire latency of an urgent temporary Critical preset raised at change_us
+// while a Warning frame is on a long (10 ms) chain.
+static uint32_t measure_critical_latency(bool supportsAbort, uint32_t change_us) {
+  StatusLed::sim::SimConfig simCfg;
+  simCfg.usPerLed = 1000;
+  simCfg.supportsAbort = supportsAbort;
+  StatusLed::sim::reset(simCfg);
+
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 10;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  leds.setAllPreset(StatusLed::StatusPreset::Ready);
+  tick_us(leds, 0);
+  tick_us(leds, 20000);  // Ready frame latched, line idle
+  leds.setAllPreset(StatusLed::StatusPreset::Info);
+  tick_us(leds, 20000);  // Stale frame starts at 20 ms
+
+  const uint32_t changeAt = 20000 + change_us;
+  tick_us(leds, changeAt);
+  leds.setTemporaryPreset(0, StatusLed::StatusPreset::Critical, 5000);
+  for (uint32_t t = changeAt; t < changeAt + 50000; t += 100) {
+    tick_us(leds, t);
+    StatusLed::sim::SimFrame frame;
+    if (StatusLed::sim::lastLatched(&frame) && frame.pixels[0] == StatusLed::RgbColor(255, 0, 0)) {
+      leds.end();
+      return frame.latchUs - changeAt;
+    }
+  }
+  leds.end();
+  TEST_FAIL_MESSAGE("critical frame never latched");
+  return 0;
+}
+
+static void test_urgent_change_supersedes_in_flight_frame() {
+  StatusLed::sim::SimConfig simCfg;
+  simCfg.usPerLed = 1000;
+  StatusLed::sim::reset(simCfg);
+
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 10;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  leds.setAllPreset(StatusLed::StatusPreset::Info);
+  tick_us(leds, 0);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+
+  // Non-urgent change while busy: overwrites the single pending frame, no abort.
+  leds.setColor(1, StatusLed::RgbColor(1, 1, 1));
+  leds.setColor(1, StatusLed::RgbColor(2, 2, 2));
+  tick_us(leds, 1000);
+  TEST_ASSERT_EQUAL_UINT32(0, leds.getFrameStats().framesAborted);
+
+  leds.setTemporaryPreset(0, StatusLed::StatusPreset::Critical, 5000);
+  tick_us(leds, 2000);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().framesAborted);
+  tick_us(leds, 2100);
+  tick_us(leds, 2200);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().aborted);
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+
+  // The urgent frame itself is never aborted, and carries the newest pending state.
+  leds.setTemporaryPreset(2, StatusLed::StatusPreset::Critical, 5000);
+  tick_us(leds, 3000);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().aborted);
+
+  StatusLed::sim::SimFrame frame;
+  tick_us(leds, 13000);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(255, 0, 0));
+  TEST_ASSERT_TRUE(frame.pixels[1] == StatusLed::RgbColor(2, 2, 2));
+
+  leds.end();
+}
+
+static void test_worst_case_change_to_wire_latency() {
+  // Frame time: 10 LEDs x 1 ms + 80 us latch. Sweep the change across one frame.
+  const uint32_t frameUs = 10 * 1000 + 80;
+  uint32_t worstAbort = 0;
+  uint32_t worstQueue = 0;
+  for (uint32_t offset = 0; offset < frameUs; offset += 500) {
+    const uint32_t withAbort = measure_critical_latency(true, offset);
+    const uint32_t withoutAbort = measure_critical_latency(false, offset);
+    worstAbort = (withAbort > worstAbort) ? withAbort : worstAbort;
+    worstQueue = (withoutAbort > worstQueue) ? withoutAbort : worstQueue;
+  }
+
+  char msg[96];
+  snprintf(msg, sizeof(msg), "worst change-to-wire: abort=%luus queued=%luus",
+           static_cast<unsigned long>(worstAbort), static_cast<unsigned long>(worstQueue));
+  TEST_MESSAGE(msg);
+
+  // Supersession bounds latency to one frame plus a latch gap and tick granularity.
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(frameUs + 80 + 1000, worstAbort);
+  TEST_ASSERT_GREATER_THAN_UINT32(worstAbort, worstQueue);
+}
+
+// Average displayed output of LED 0 over `cycles` cycles, sampled every 1 ms
+// from the simulated wire (8.8 fixed point, like PowerReport).
+struct TraceAverage {
+  uint32_t red = 0;
+  uint32_t green = 0;
+  uint32_t blue = 0;
+};
+
+static TraceAverage trace_average(StatusLed::StatusLed& leds, uint32_t cycleMs, uint32_t cycles) {
+  uint64_t red = 0;
+  uint64_t green = 0;
+  uint64_t blue = 0;
+  const uint32_t totalMs = cycleMs * cycles;
+  for (uint32_t t = 0; t < totalMs; ++t) {
+    tick_us(leds, t * 1000u);
+    StatusLed::sim::setTimeUs(t * 1000u + 500u);  // Sample after the latch gap
+    StatusLed::sim::SimFrame frame;
+    TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+    red += frame.pixels[0].r;
+    green += frame.pixels[0].g;
+    blue += frame.pixels[0].b;
+  }
+  TraceAverage avg;
+  avg.red = static_cast<uint32_t>(red * 256u / totalMs);
+  avg.green = static_cast<uint32_t>(green * 256u / totalMs);
+  avg.blue = static_cast<uint32_t>(blue * 256u / totalMs);
+  return avg;
+}
+
+static void check_preset_power_matches_trace(StatusLed::StatusPreset preset, uint32_t cycles) {
+  StatusLed::PowerReport report;
+  const StatusLed::PowerModel model;
+  TEST_ASSERT_TRUE(StatusLed::StatusLed::estimatePresetPower(preset, 200, 255, model, &report).ok());
+  TEST_ASSERT_GREATER_THAN_UINT32(0, report.cycleMs);
+
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setBrightness(0, 200).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, preset).ok());
+  const TraceAverage trace = trace_average(leds, report.cycleMs, cycles);
+  leds.end();
+
+  // 2% of full scale covers smooth-mode sampling at smoothStepMs.
+  const uint32_t tolerance = 0xFF00u / 50u;
+  TEST_ASSERT_UINT32_WITHIN(tolerance, report.red, trace.red);
+  TEST_ASSERT_UINT32_WITHIN(tolerance, report.green, trace.green);
+  TEST_ASSERT_UINT32_WITHIN(tolerance, report.blue, trace.blue);
+}
+
+static void test_power_estimate_matches_simulated_trace() {
+  check_preset_power_matches_trace(StatusLed::StatusPreset::LowBattery, 2);
+  check_preset_power_matches_trace(StatusLed::StatusPreset::Connecting, 2);
+  check_preset_power_matches_trace(StatusLed::StatusPreset::Error, 8);
+  check_preset_power_matches_trace(StatusLed::StatusPreset::Updating, 2);
+  check_preset_power_matches_trace(StatusLed::StatusPreset::AlarmPolice, 4);
+  check_preset_power_matches_trace(StatusLed::StatusPreset::Maintenance, 4);
+}
+
+static void test_power_estimate_exact_for_step_patterns() {
+  StatusLed::PowerModel model;
+  model.idleUa = 500;
+  StatusLed::PowerReport report;
+  // Beacon: 80 ms of 255 in a 4000 ms cycle.
+  TEST_ASSERT_TRUE(StatusLed::StatusLed::estimatePower(
+                       StatusLed::Mode::Beacon, StatusLed::StatusLed::getModeDefaults(
+                                                    StatusLed::Mode::Beacon),
+                       StatusLed::RgbColor(255, 0, 0), StatusLed::RgbColor(), 255, 255, model,
+                       &report)
+                       .ok());
+  TEST_ASSERT_EQUAL_UINT32(4000, report.cycleMs);
+  TEST_ASSERT_EQUAL_UINT16(20, report.dutyPermille);
+  TEST_ASSERT_EQUAL_UINT16((255u * 256u * 80u + 2000u) / 4000u, report.red);
+  TEST_ASSERT_EQUAL_UINT16(0, report.green);
+  TEST_ASSERT_EQUAL_UINT32(500 + 12000 * 80 / 4000, report.currentUa);
+
+  // LowBattery (Beacon) must budget well below Connecting (PulseSoft).
+  StatusLed::PowerReport connecting;
+  TEST_ASSERT_TRUE(StatusLed::StatusLed::estimatePresetPower(StatusLed::StatusPreset::Connecting,
+                                                             255, 255, model, &connecting)
+                       .ok());
+  TEST_ASSERT_GREATER_THAN_UINT32(report.currentUa * 5, connecting.currentUa);
+
+  // Constant modes report a zero-length cycle.
+  TEST_ASSERT_TRUE(StatusLed::StatusLed::estimatePower(
+                       StatusLed::Mode::Solid, StatusLed::ModeParams(),
+                       StatusLed::RgbColor(255, 255, 255), StatusLed::RgbColor(), 255, 255, model,
+                       &report)
+                       .ok());
+  TEST_ASSERT_EQUAL_UINT32(0, report.cycleMs);
+  TEST_ASSERT_EQUAL_UINT16(1000, report.dutyPermille);
+  TEST_ASSERT_EQUAL_UINT32(500 + 3 * 12000, report.currentUa);
+
+  const StatusLed::Status packSt = StatusLed::StatusLed::estimatePower(
+      StatusLed::Mode::PackPattern, StatusLed::ModeParams(), StatusLed::RgbColor(),
+      StatusLed::RgbColor(), 255, 255, model, &report);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::UNSUPPORTED),
+                           static_cast<uint16_t>(packSt.code));
+  TEST_ASSERT_FALSE(StatusLed::StatusLed::estimatePower(StatusLed::Mode::Solid,
+                                                        StatusLed::ModeParams(),
+                                                        StatusLed::RgbColor(),
+                                                        StatusLed::RgbColor(), 255, 255, model,
+                                                        nullptr)
+                        .ok());
+}
+
+// BlinkFast reimplemented through the custom evaluator interface.
+static StatusLed::CustomStep custom_blink(const StatusLed::CustomContext& ctx, uint32_t) {
+  ++*static_cast<uint32_t*>(ctx.user);
+  ctx.state[0] ^= 1u;
+  StatusLed::CustomStep step;
+  step.intensity = ctx.state[0] ? 255 : 0;
+  step.nextChangeMs = ctx.state[0] ? ctx.params->onMs
+                                   : static_cast<uint32_t>(ctx.params->periodMs - ctx.params->onMs);
+  return step;
+}
+
+struct SensorInput {
+  uint8_t level = 0;
+  uint32_t calls = 0;
+};
+
+// Follows a sensor value and holds until woken.
+static StatusLed::CustomStep custom_sensor(const StatusLed::CustomContext& ctx, uint32_t) {
+  SensorInput* input = static_cast<SensorInput*>(ctx.user);
+  ++input->calls;
+  StatusLed::CustomStep step;
+  step.intensity = input->level;
+  return step;
+}
+
+static void test_custom_mode_matches_builtin_blink() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 2;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+
+  const StatusLed::ModeParams params = StatusLed::StatusLed::getModeDefaults(
+      StatusLed::Mode::BlinkFast);
+  uint32_t calls = 0;
+  TEST_ASSERT_TRUE(leds.setMode(0, StatusLed::Mode::BlinkFast, params).ok());
+  TEST_ASSERT_TRUE(leds.setCustomMode(1, custom_blink, &calls, params).ok());
+
+  StatusLed::LedSnapshot builtin;
+  StatusLed::LedSnapshot custom;
+  for (uint32_t t = 0; t <= 1000; ++t) {
+    leds.tick(t);
+    TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &builtin).ok());
+    TEST_ASSERT_TRUE(leds.getLedSnapshot(1, &custom).ok());
+    TEST_ASSERT_EQUAL_UINT8(builtin.intensity, custom.intensity);
+  }
+  TEST_ASSERT_TRUE(custom.mode == StatusLed::Mode::Custom);
+  // Called only on scheduler wakeups: one per 125 ms edge, not per tick.
+  TEST_ASSERT_EQUAL_UINT32(9, calls);
+
+  leds.end();
+}
+
+static void test_custom_mode_holds_until_woken() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  SensorInput input;
+  input.level = 100;
+  TEST_ASSERT_TRUE(leds.setCustomMode(0, custom_sensor, &input).ok());
+
+  StatusLed::LedSnapshot snap;
+  leds.tick(0);
+  input.level = 200;
+  leds.tick(500);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(100, snap.intensity);
+  TEST_ASSERT_EQUAL_UINT32(1, input.calls);
+
+  TEST_ASSERT_TRUE(leds.wakeCustom(0).ok());
+  leds.tick(501);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(200, snap.intensity);
+  TEST_ASSERT_EQUAL_UINT32(2, input.calls);
+
+  // A temporary preset suspends the evaluator and resumes it afterwards.
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(0, StatusLed::StatusPreset::Error, 100).ok());
+  leds.tick(502);
+  leds.tick(700);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_TRUE(snap.mode == StatusLed::Mode::Custom);
+  TEST_ASSERT_EQUAL_UINT8(200, snap.intensity);
+  TEST_ASSERT_EQUAL_UINT32(3, input.calls);
+
+  TEST_ASSERT_FALSE(leds.setCustomMode(0, nullptr).ok());
+  TEST_ASSERT_FALSE(leds.setMode(0, StatusLed::Mode::Custom).ok());
+  TEST_ASSERT_TRUE(leds.setMode(0, StatusLed::Mode::Solid).ok());
+  TEST_ASSERT_FALSE(leds.wakeCustom(0).ok());
+
+  leds.end();
+}
+
+static void test_ext_pool_fragmentation_and_exhaustion() {
+  StatusLed::ExtPool pool;
+  TEST_ASSERT_FALSE(pool.begin(StatusLed::kMaxExtBlocks + 1).ok());
+  TEST_ASSERT_TRUE(pool.begin(4).ok());
+  TEST_ASSERT_EQUAL_UINT8(4, pool.available());
+
+  uint8_t blocks[4];
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < 4; ++i) {
+    TEST_ASSERT_TRUE(pool.acquire(&blocks[i]).ok());
+    TEST_ASSERT_TRUE(blocks[i] < 4);
+    seen |= 1u << blocks[i];
+    memset(pool.data(blocks[i]), 0xA0 + i, StatusLed::kExtBlockSize);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0x0F, seen);
+
+  uint8_t extra = 0;
+  const StatusLed::Status st = pool.acquire(&extra);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::OUT_OF_MEMORY),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT8(StatusLed::kNoExtBlock, extra);
+
+  // Free non-adjacent blocks; both holes are reusable and neighbours untouched.
+  pool.release(blocks[1]);
+  pool.release(blocks[3]);
+  pool.release(blocks[3]);  // Double release ignored
+  pool.release(StatusLed::kNoExtBlock);
+  TEST_ASSERT_EQUAL_UINT8(2, pool.available());
+  uint8_t a = 0;
+  uint8_t b = 0;
+  TEST_ASSERT_TRUE(pool.acquire(&a).ok());
+  TEST_ASSERT_TRUE(pool.acquire(&b).ok());
+  TEST_ASSERT_TRUE((a == blocks[1] && b == blocks[3]) || (a == blocks[3] && b == blocks[1]));
+  TEST_ASSERT_FALSE(pool.acquire(&extra).ok());
+  for (size_t i = 0; i < StatusLed::kExtBlockSize; ++i) {
+    TEST_ASSERT_EQUAL_UINT8(0xA0, pool.data(blocks[0])[i]);
+    TEST_ASSERT_EQUAL_UINT8(0xA2, pool.data(blocks[2])[i]);
+  }
+
+  TEST_ASSERT_TRUE(pool.begin(0).ok());
+  TEST_ASSERT_FALSE(pool.acquire(&extra).ok());
+}
+
+static StatusLed::CustomStep custom_hold(const StatusLed::CustomContext&, uint32_t) {
+  return StatusLed::CustomStep();
+}
+
+static void test_custom_mode_reports_ext_pool_exhaustion() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 3;
+  cfg.extBlockCount = StatusLed::kMaxExtBlocks + 1;
+  TEST_ASSERT_FALSE(leds.begin(cfg).ok());
+  cfg.extBlockCount = 2;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_EQUAL_UINT8(2, leds.extBlocksAvailable());
+
+  TEST_ASSERT_TRUE(leds.setCustomMode(0, custom_hold).ok());
+  TEST_ASSERT_TRUE(leds.setCustomMode(1, custom_hold).ok());
+  TEST_ASSERT_TRUE(leds.setCustomMode(1, custom_hold).ok());  // Reuses its block
+  const StatusLed::Status st = leds.setCustomMode(2, custom_hold);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::OUT_OF_MEMORY),
+                           static_cast<uint16_t>(st.code));
+  StatusLed::LedSnapshot snap;
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(2, &snap).ok());
+  TEST_ASSERT_TRUE(snap.mode == StatusLed::Mode::Off);
+
+  // A temporary preset keeps the suspended evaluator's block.
+  leds.tick(0);
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(1, StatusLed::StatusPreset::Error, 100).ok());
+  leds.tick(1);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.extBlocksAvailable());
+  leds.tick(200);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(1, &snap).ok());
+  TEST_ASSERT_TRUE(snap.mode == StatusLed::Mode::Custom);
+
+  // Leaving Mode::Custom returns the block.
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  TEST_ASSERT_EQUAL_UINT8(1, leds.extBlocksAvailable());
+  TEST_ASSERT_TRUE(leds.setCustomMode(2, custom_hold).ok());
+  TEST_ASSERT_TRUE(leds.clear().ok());
+  TEST_ASSERT_EQUAL_UINT8(2, leds.extBlocksAvailable());
+
+  leds.end();
+}
+
+static void test_ext_pool_acquire_release_cost() {
+  StatusLed::ExtPool pool;
+  TEST_ASSERT_TRUE(pool.begin(StatusLed::kMaxExtBlocks).ok());
+  uint8_t held[StatusLed::kMaxExtBlocks];
+  const uint32_t rounds = 20000;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < rounds; ++r) {
+    for (uint8_t i = 0; i < StatusLed::kMaxExtBlocks; ++i) {
+      pool.acquire(&held[i]);
+    }
+    // Release in a strided order so the free list is scrambled each round.
+    for (uint8_t i = 0; i < StatusLed::kMaxExtBlocks; ++i) {
+      pool.release(held[(i * 5u + r) % StatusLed::kMaxExtBlocks]);
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const double ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  const double ops = 2.0 * rounds * StatusLed::kMaxExtBlocks;
+
+  char msg[80];
+  snprintf(msg, sizeof(msg), "ext pool acquire+release: %.1f ns/op", ns / ops);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT8(StatusLed::kMaxExtBlocks, pool.available());
+}
+
+static void test_tick_visits_only_active_leds() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = StatusLed::StatusLed::kMaxLedCount;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_EQUAL_UINT8(cfg.ledCount, leds.activeLedCount());
+
+  // Static LEDs leave the active set after their first update.
+  leds.tick(0);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.activeLedCount());
+  TEST_ASSERT_TRUE(leds.setPreset(3, StatusLed::StatusPreset::Ready).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(7, StatusLed::StatusPreset::Error).ok());
+  TEST_ASSERT_EQUAL_UINT8(2, leds.activeLedCount());
+  leds.tick(1);
+  TEST_ASSERT_EQUAL_UINT8(1, leds.activeLedCount());
+
+  StatusLed::LedSnapshot snap;
+  leds.tick(126);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(7, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(0, snap.intensity);
+
+  // A temporary preset on a static LED keeps it active until it reverts.
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(3, StatusLed::StatusPreset::Info, 100).ok());
+  leds.tick(130);
+  TEST_ASSERT_EQUAL_UINT8(2, leds.activeLedCount());
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(3, &snap).ok());
+  TEST_ASSERT_TRUE(snap.tempActive);
+  leds.tick(230);
+  leds.tick(231);
+  TEST_ASSERT_EQUAL_UINT8(1, leds.activeLedCount());
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(3, &snap).ok());
+  TEST_ASSERT_TRUE(snap.preset == StatusLed::StatusPreset::Ready);
+  TEST_ASSERT_EQUAL_UINT8(255, snap.intensity);
+
+  TEST_ASSERT_TRUE(leds.clear().ok());
+  leds.tick(232);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.activeLedCount());
+
+  leds.end();
+}
+
+static void test_lost_completion_recovers_after_deadline() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  StatusLed::sim::loseCompletions(1);
+  tick_us(leds, 0);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+
+  // The frame reaches the LEDs but the wire never reports done.
+  StatusLed::sim::SimFrame frame;
+  leds.setColor(0, StatusLed::RgbColor(255, 0, 0));
+  tick_us(leds, 5000);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(0, 255, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  TEST_ASSERT_EQUAL_UINT32(0, leds.getFrameStats().txTimeouts);
+
+  // Deadline: 1 LED x 30 us + 80 us latch + 20 ms margin.
+  tick_us(leds, 20109);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  tick_us(leds, 20110);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().stallRecoveries);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::TIMEOUT),
+                           static_cast<uint16_t>(leds.getLastStatus().code));
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+
+  tick_us(leds, 21000);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(255, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+
+  leds.end();
+}
+
+static void test_lost_completion_recovers_without_new_changes() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  StatusLed::sim::loseCompletions(1);
+  tick_us(leds, 0);
+  const uint32_t version = leds.stateVersion();
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+
+  // Nothing else changes: the stall is still recovered at the deadline.
+  tick_us(leds, 20109);
+  TEST_ASSERT_EQUAL_UINT32(0, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_FALSE(leds.isDisplayed(version));
+  tick_us(leds, 20110);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+
+  // The retransmit acknowledges the change.
+  tick_us(leds, 21000);
+  TEST_ASSERT_TRUE(leds.isDisplayed(version));
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+
+  leds.end();
+}
+
+struct AckLog {
+  uint32_t calls = 0;
+  StatusLed::DisplayAck last{};
+};
+
+static void record_ack(const StatusLed::DisplayAck& ack, void* user) {
+  AckLog* log = static_cast<AckLog*>(user);
+  ++log->calls;
+  log->last = ack;
+}
+
+static void test_display_ack_confirms_change_on_wire() {
+  StatusLed::sim::SimConfig simCfg;
+  simCfg.usPerLed = 1000;
+  StatusLed::sim::reset(simCfg);
+
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 10;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  AckLog log;
+  leds.setDisplayAckCallback(&record_ack, &log);
+  tick_us(leds, 0);
+  tick_us(leds, 11000);  // Initial blank frame latched at 10080 us
+  TEST_ASSERT_EQUAL_UINT32(1, log.calls);
+  TEST_ASSERT_EQUAL_UINT32(leds.stateVersion(), leds.displayedVersion());
+
+  // Returning Ok is not display: the change is confirmed when its frame completes.
+  tick_us(leds, 12000);
+  TEST_ASSERT_TRUE(leds.setAllPreset(StatusLed::StatusPreset::Ready).ok());
+  const uint32_t ready = leds.stateVersion();
+  TEST_ASSERT_FALSE(leds.isDisplayed(ready));
+  tick_us(leds, 12500);
+  tick_us(leds, 22579);
+  TEST_ASSERT_FALSE(leds.isDisplayed(ready));
+  tick_us(leds, 22580);
+  TEST_ASSERT_TRUE(leds.isDisplayed(ready));
+  TEST_ASSERT_EQUAL_UINT32(2, log.calls);
+  TEST_ASSERT_EQUAL_UINT32(2, log.last.frameSeq);
+  TEST_ASSERT_EQUAL_UINT32(ready, log.last.version);
+  TEST_ASSERT_EQUAL_UINT32(12000, log.last.changeUs);
+  TEST_ASSERT_EQUAL_UINT32(22580, log.last.displayedUs);
+  TEST_ASSERT_EQUAL_UINT32(10580, log.last.latencyUs);
+
+  // An aborted frame confirms nothing; its replacement confirms both changes,
+  // with latency measured from the older one.
+  TEST_ASSERT_TRUE(leds.setAllPreset(StatusLed::StatusPreset::Info).ok());
+  const uint32_t info = leds.stateVersion();
+  tick_us(leds, 23000);
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(0, StatusLed::StatusPreset::Critical, 5000).ok());
+  const uint32_t critical = leds.stateVersion();
+  tick_us(leds, 24000);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().framesAborted);
+  TEST_ASSERT_FALSE(leds.isDisplayed(info));
+  for (uint32_t t = 24100; t < 40000 && !leds.isDisplayed(critical); t += 100) {
+    tick_us(leds, t);
+  }
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(255, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(3, log.calls);
+  TEST_ASSERT_EQUAL_UINT32(4, log.last.frameSeq);
+  TEST_ASSERT_EQUAL_UINT32(leds.stateVersion(), log.last.version);  // Includes the activation
+  TEST_ASSERT_EQUAL_UINT32(22580, log.last.changeUs);
+  TEST_ASSERT_EQUAL_UINT32(frame.latchUs, log.last.displayedUs);
+
+  char msg[96];
+  snprintf(msg, sizeof(msg), "api-to-wire (ack): idle=%luus superseded=%luus", 10580ul,
+           static_cast<unsigned long>(log.last.latencyUs));
+  TEST_MESSAGE(msg);
+
+  // A change that alters no pixel is confirmed once nothing is pending.
+  TEST_ASSERT_TRUE(leds.setDefaultPreset(9, StatusLed::StatusPreset::Ready).ok());
+  const uint32_t same = leds.stateVersion();
+  tick_us(leds, 40100);
+  TEST_ASSERT_TRUE(leds.isDisplayed(same));
+  TEST_ASSERT_EQUAL_UINT32(4, log.calls);
+  TEST_ASSERT_EQUAL_UINT32(4, leds.getFrameStats().framesSent);
+
+  leds.end();
+}
+
+static void test_layout_tables_serpentine_reversed_and_map() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 9;
+  cfg.layout.kind = StatusLed::LayoutKind::Matrix;
+  cfg.layout.width = 3;
+  cfg.layout.height = 3;
+  cfg.layout.serpentine = true;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  // Row 1 runs right to left: 5 4 3.
+  const uint8_t expected[9] = {0, 1, 2, 5, 4, 3, 6, 7, 8};
+  for (uint8_t y = 0; y < 3; ++y) {
+    for (uint8_t x = 0; x < 3; ++x) {
+      const uint8_t index = leds.getLayout().indexAt(x, y);
+      TEST_ASSERT_EQUAL_UINT8(expected[y * 3 + x], index);
+      TEST_ASSERT_EQUAL_UINT8(x, leds.getLayout().x(index));
+      TEST_ASSERT_EQUAL_UINT8(y, leds.getLayout().y(index));
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT8(StatusLed::kNoLayoutLed, leds.getLayout().indexAt(3, 0));
+
+  // Reversed: data enters at the last cell; 8 LEDs leave the first cell empty.
+  cfg.ledCount = 8;
+  cfg.layout.reversed = true;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_EQUAL_UINT8(0, leds.getLayout().indexAt(2, 2));
+  TEST_ASSERT_EQUAL_UINT8(3, leds.getLayout().indexAt(0, 1));
+  TEST_ASSERT_EQUAL_UINT8(StatusLed::kNoLayoutLed, leds.getLayout().indexAt(0, 0));
+
+  // Explicit map with a hole; the caller's table is only read by begin().
+  uint8_t map[6] = {2, StatusLed::kNoLayoutLed, 0, 1, 4, 3};
+  cfg.ledCount = 5;
+  cfg.layout = StatusLed::Layout();
+  cfg.layout.kind = StatusLed::LayoutKind::Map;
+  cfg.layout.width = 3;
+  cfg.layout.height = 2;
+  cfg.layout.map = map;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  memset(map, 0, sizeof(map));
+  TEST_ASSERT_EQUAL_UINT8(2, leds.getLayout().indexAt(0, 0));
+  TEST_ASSERT_EQUAL_UINT8(StatusLed::kNoLayoutLed, leds.getLayout().indexAt(1, 0));
+  TEST_ASSERT_EQUAL_UINT8(1, leds.getLayout().x(4));
+  TEST_ASSERT_EQUAL_UINT8(1, leds.getLayout().y(4));
+
+  // Duplicate, missing, oversized.
+  const uint8_t dup[6] = {0, 0, 1, 2, 3, 4};
+  const uint8_t missing[6] = {0, 1, 2, 3, StatusLed::kNoLayoutLed, StatusLed::kNoLayoutLed};
+  cfg.layout.map = dup;
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.layout.map = missing;
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.layout.kind = StatusLed::LayoutKind::Matrix;
+  cfg.layout.width = 2;
+  cfg.layout.height = 2;
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(leds.begin(cfg).code));
+  leds.end();
+}
+
+static uint8_t intensity_at(const StatusLed::StatusLed& leds, uint8_t x, uint8_t y) {
+  StatusLed::LedSnapshot snap;
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(leds.getLayout().indexAt(x, y), &snap).ok());
+  return snap.intensity;
+}
+
+static void test_spatial_effects_follow_layout_distance() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 9;
+  cfg.layout.kind = StatusLed::LayoutKind::Matrix;
+  cfg.layout.width = 3;
+  cfg.layout.height = 3;
+  cfg.layout.serpentine = true;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+
+  StatusLed::SpatialParams params;
+  params.periodMs = 1000;
+  params.bandMs = 200;
+  params.msPerCell = 100;
+  params.originX = 1;
+  params.originY = 1;
+  const StatusLed::RgbColor white(255, 255, 255);
+  TEST_ASSERT_TRUE(leds.setSpatialEffect(StatusLed::SpatialEffect::RadialPulse, white, params).ok());
+
+  // Center peaks at bandMs/2; edges (1 cell) 100 ms later; corners (1.41 cells) after that.
+  leds.tick(100);
+  TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, 1, 1));
+  TEST_ASSERT_EQUAL_UINT8(0, intensity_at(leds, 1, 0));
+  TEST_ASSERT_EQUAL_UINT8(0, intensity_at(leds, 0, 0));
+  leds.tick(200);
+  TEST_ASSERT_EQUAL_UINT8(0, intensity_at(leds, 1, 1));
+  TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, 0, 1));
+  TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, 2, 1));
+  TEST_ASSERT_TRUE(intensity_at(leds, 2, 2) > 0 && intensity_at(leds, 2, 2) < 255);
+  leds.tick(1100);  // Next cycle
+  TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, 1, 1));
+
+  // Ripple fades with distance.
+  TEST_ASSERT_TRUE(leds.setSpatialEffect(StatusLed::SpatialEffect::Ripple, white, params).ok());
+  leds.tick(1200);
+  TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, 1, 1));
+  leds.tick(1337);  // Effect restarted at 1100
+  TEST_ASSERT_TRUE(intensity_at(leds, 0, 2) > 0 && intensity_at(leds, 0, 2) < 128);
+
+  // Row sweep from the top row, regardless of serpentine wiring.
+  params.originY = 0;
+  TEST_ASSERT_TRUE(leds.setSpatialEffect(StatusLed::SpatialEffect::RowSweep, white, params).ok());
+  leds.tick(1437);  // Effect restarted at 1337
+  for (uint8_t x = 0; x < 3; ++x) {
+    TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, x, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, intensity_at(leds, x, 1));
+  }
+  leds.tick(1537);
+  for (uint8_t x = 0; x < 3; ++x) {
+    TEST_ASSERT_EQUAL_UINT8(255, intensity_at(leds, x, 1));
+  }
+
+  params.originX = 3;
+  TEST_ASSERT_EQUAL_UINT16(
+      static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+      static_cast<uint16_t>(leds.setSpatialEffect(StatusLed::SpatialEffect::RowSweep, white, params).code));
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(leds.setMode(0, StatusLed::Mode::Spatial).code));
+  leds.end();
+}
+
+static void test_frame_clock_matches_deadlines_and_batches_frames() {
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 5;
+  StatusLed::StatusLed deadline;
+  StatusLed::StatusLed clocked;
+  TEST_ASSERT_TRUE(deadline.begin(cfg).ok());
+  cfg.frameClockMs = 20;
+  TEST_ASSERT_TRUE(clocked.begin(cfg).ok());
+  StatusLed::StatusLed* engines[2] = {&deadline, &clocked};
+  for (StatusLed::StatusLed* leds : engines) {
+    TEST_ASSERT_TRUE(leds->setMode(0, StatusLed::Mode::PulseSoft).ok());
+    TEST_ASSERT_TRUE(leds->setMode(1, StatusLed::Mode::Breathing).ok());
+    TEST_ASSERT_TRUE(leds->setPreset(2, StatusLed::StatusPreset::Ready).ok());
+    TEST_ASSERT_TRUE(leds->setMode(3, StatusLed::Mode::BlinkSlow).ok());
+    TEST_ASSERT_TRUE(leds->setMode(4, StatusLed::Mode::Heartbeat).ok());
+  }
+
+  // Both engines share the simulated wire; only the clocked one is checked against it.
+  uint32_t lastStarted = 0;
+  uint32_t lastPeriod = 0xFFFFFFFFu;
+  for (uint32_t t = 0; t <= 2000; ++t) {
+    deadline.tick(t);
+    StatusLed::sim::setTimeUs(t * 1000u);
+    const uint32_t before = StatusLed::sim::stats().started;
+    clocked.tick(t);
+    const uint32_t started = StatusLed::sim::stats().started;
+    if (started != before) {
+      // One frame per period, on its edge or as soon as the shared wire frees up.
+      TEST_ASSERT_TRUE(t % 20 <= 1);
+      TEST_ASSERT_TRUE(lastPeriod == 0xFFFFFFFFu || t / 20 > lastPeriod);
+      TEST_ASSERT_TRUE(started == before + 1);
+      lastPeriod = t / 20;
+      lastStarted = started;
+    }
+    if (t % 20 == 0) {
+      for (uint8_t i = 0; i < 5; ++i) {
+        StatusLed::LedSnapshot a;
+        StatusLed::LedSnapshot b;
+        TEST_ASSERT_TRUE(deadline.getLedSnapshot(i, &a).ok());
+        TEST_ASSERT_TRUE(clocked.getLedSnapshot(i, &b).ok());
+        TEST_ASSERT_EQUAL_UINT8(a.intensity, b.intensity);
+      }
+    }
+  }
+  TEST_ASSERT_TRUE(lastStarted > 0 && lastStarted <= 2000 / 20 + 1);
+
+  cfg.frameClockMs = 3;
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(clocked.begin(cfg).code));
+  deadline.end();
+  clocked.end();
+}
+
+static void test_frame_clock_keeps_output_stage_running_between_edges() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.frameClockMs = 100;  // Longer than the 20 ms stall deadline
+  cfg.powerPin = 5;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 0);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+
+  // The display ack arrives on the next tick, not the next edge.
+  tick_us(leds, 1000);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+
+  // Changes wait for an edge.
+  StatusLed::sim::loseCompletions(1);
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(255, 0, 0)).ok());
+  tick_us(leds, 2000);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  tick_us(leds, 100000);
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+
+  // Its completion is lost: recovered at the stall deadline, mid-period.
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 0, 255)).ok());
+  tick_us(leds, 101000);
+  TEST_ASSERT_EQUAL_UINT32(0, leds.getFrameStats().txTimeouts);
+  tick_us(leds, 125000);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+  tick_us(leds, 200000);
+  TEST_ASSERT_EQUAL_UINT32(3, StatusLed::sim::stats().started);
+
+  // The rail is cut as soon as the black frame latched.
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Off).ok());
+  tick_us(leds, 300000);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  tick_us(leds, 301000);
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(4, StatusLed::sim::stats().started);
+
+  // A frame held back on its edge (rail settling) goes out once the rail is ready.
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 350000);
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  tick_us(leds, 400000);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(4, StatusLed::sim::stats().started);
+  tick_us(leds, 402000);
+  TEST_ASSERT_EQUAL_UINT32(5, StatusLed::sim::stats().started);
+
+  // Urgent frames do not wait for the edge.
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Critical).ok());
+  tick_us(leds, 410000);
+  TEST_ASSERT_EQUAL_UINT32(6, StatusLed::sim::stats().started);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(255, 0, 0));
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(0, StatusLed::StatusPreset::Ready, 1000).ok());
+  tick_us(leds, 420000);
+  TEST_ASSERT_EQUAL_UINT32(7, StatusLed::sim::stats().started);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(0, 255, 0));
+  leds.end();
+}
+
+// CPU time per simulated second (us), ticking every tickMs for 10 s, best of 3.
+static double bench_us_per_second(uint8_t ledCount, uint8_t animated, uint16_t frameClockMs,
+                                  uint32_t tickMs) {
+  double best = 0;
+  for (int rep = 0; rep < 3; ++rep) {
+    StatusLed::sim::reset();
+    StatusLed::StatusLed leds;
+    StatusLed::Config cfg = make_config();
+    cfg.ledCount = ledCount;
+    cfg.frameClockMs = frameClockMs;
+    TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+    for (uint8_t i = 0; i < ledCount; ++i) {
+      if (i < animated) {
+        leds.setMode(i, (i & 1u) ? StatusLed::Mode::BlinkSlow : StatusLed::Mode::PulseSoft);
+      } else {
+        leds.setPreset(i, StatusLed::StatusPreset::Ready);
+      }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < 10000; t += tickMs) {
+      StatusLed::sim::setTimeUs(t * 1000u);
+      leds.tick(t);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double us = static_cast<double>(
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                      1000.0 / 10.0;
+    best = (rep == 0 || us < best) ? us : best;
+    leds.end();
+  }
+  return best;
+}
+
+static void test_frame_clock_crossover_benchmark() {
+  // Animated LEDs alternate PulseSoft (20 ms steps) and BlinkSlow; the rest are static.
+  // A 1 ms loop favors the clock (idle ticks skip LED evaluation); a loop already
+  // running at the clock rate favors deadlines (only active LEDs are visited).
+  const uint32_t tickPeriods[] = {1, 20};
+  const uint8_t counts[] = {1, 4, 10};
+  for (uint32_t tickMs : tickPeriods) {
+    for (uint8_t n : counts) {
+      int crossover = -1;
+      for (uint8_t animated = 0; animated <= n; ++animated) {
+        const double perLed = bench_us_per_second(n, animated, 0, tickMs);
+        const double clock = bench_us_per_second(n, animated, 20, tickMs);
+        if (animated == 0 || animated == n || animated == n / 2) {
+          char msg[112];
+          snprintf(msg, sizeof(msg),
+                   "tick=%lums n=%u animated=%u: deadlines=%.2f clock50Hz=%.2f us/s",
+                   static_cast<unsigned long>(tickMs), n, animated, perLed, clock);
+          TEST_MESSAGE(msg);
+        }
+        if (crossover < 0 && clock < perLed) {
+          crossover = animated;
+        }
+      }
+      char msg[96];
+      if (crossover < 0) {
+        snprintf(msg, sizeof(msg), "crossover tick=%lums n=%u: deadlines always cheaper",
+                 static_cast<unsigned long>(tickMs), n);
+      } else {
+        snprintf(msg, sizeof(msg), "crossover tick=%lums n=%u: clock cheaper from %d animated",
+                 static_cast<unsigned long>(tickMs), n, crossover);
+      }
+      TEST_MESSAGE(msg);
+    }
+  }
+}
+
+static void make_serializer_engine(StatusLed::StatusLed& leds) {
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 2;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(leds.setMode(0, StatusLed::Mode::Solid).ok());
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(255, 16, 0)).ok());
+  TEST_ASSERT_TRUE(leds.setBrightness(1, 128).ok());
+}
+
+struct SinkCapture {
+  uint8_t data[1024];
+  size_t len = 0;
+  size_t calls = 0;
+  size_t largest = 0;
+  size_t failAfter = 0;  // 0 = never fail
+};
+
+static bool capture_sink(const uint8_t* data, size_t len, void* user) {
+  SinkCapture* c = static_cast<SinkCapture*>(user);
+  ++c->calls;
+  c->largest = (len > c->largest) ? len : c->largest;
+  if (c->failAfter != 0 && c->calls >= c->failAfter) {
+    return false;
+  }
+  if (c->len + len <= sizeof(c->data)) {
+    memcpy(c->data + c->len, data, len);
+  }
+  c->len += len;
+  return true;
+}
+
+// Minimal CBOR walker: returns bytes consumed by one item, 0 on malformed input.
+static size_t cbor_item_size(const uint8_t* p, size_t len) {
+  if (len == 0) {
+    return 0;
+  }
+  const uint8_t major = static_cast<uint8_t>(p[0] >> 5);
+  const uint8_t info = static_cast<uint8_t>(p[0] & 0x1F);
+  size_t pos = 1;
+  uint32_t arg = info;
+  if (info == 24 || info == 25 || info == 26) {
+    const size_t n = (info == 24) ? 1 : (info == 25) ? 2 : 4;
+    if (len < 1 + n) {
+      return 0;
+    }
+    arg = 0;
+    for (size_t i = 0; i < n; ++i) {
+      arg = (arg << 8) | p[1 + i];
+    }
+    pos += n;
+  } else if (info == 31) {
+    if (major != 4 && major != 5) {
+      return 0;
+    }
+    while (pos < len && p[pos] != 0xFF) {
+      const size_t item = cbor_item_size(p + pos, len - pos);
+      if (item == 0) {
+        return 0;
+      }
+      pos += item;
+    }
+    return (pos < len) ? pos + 1 : 0;
+  } else if (info > 24) {
+    return 0;
+  }
+  switch (major) {
+    case 0:
+      return pos;
+    case 3:
+      return (pos + arg <= len) ? pos + arg : 0;
+    case 4:
+    case 5: {
+      const uint32_t items = (major == 5) ? arg * 2 : arg;
+      for (uint32_t i = 0; i < items; ++i) {
+        const size_t item = cbor_item_size(p + pos, len - pos);
+        if (item == 0) {
+          return 0;
+        }
+        pos += item;
+      }
+      return pos;
+    }
+    case 7:
+      return (info == 20 || info == 21) ? pos : 0;
+    default:
+      return 0;
+  }
+}
+
+static void test_serializer_json_state_and_changes() {
+  StatusLed::StatusLed leds;
+  make_serializer_engine(leds);
+
+  char json[512];
+  StatusLed::SerialOutput out;
+  out.buffer = reinterpret_cast<uint8_t*>(json);
+  out.capacity = sizeof(json);
+  TEST_ASSERT_TRUE(StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &out).ok());
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"version\":5,\"displayed\":0,\"leds\":["
+      "{\"i\":0,\"v\":4,\"mode\":\"solid\",\"preset\":\"off\",\"default\":\"off\","
+      "\"color\":[255,16,0],\"alt\":[0,0,0],\"bri\":255,\"int\":0,"
+      "\"temp\":false,\"tempMs\":0,\"pack\":0},"
+      "{\"i\":1,\"v\":5,\"mode\":\"off\",\"preset\":\"off\",\"default\":\"off\","
+      "\"color\":[0,0,0],\"alt\":[0,0,0],\"bri\":128,\"int\":0,"
+      "\"temp\":false,\"tempMs\":0,\"pack\":0}]}",
+      json);
+  TEST_ASSERT_EQUAL_UINT32(strlen(json), out.written);
+
+  // begin() versions both LEDs; only LED 1 changed after version 4.
+  TEST_ASSERT_TRUE(
+      StatusLed::serializeChanges(leds, 4, StatusLed::SerialFormat::Json, &out).ok());
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"since\":4,\"version\":5,\"changes\":["
+      "{\"i\":1,\"v\":5,\"mode\":\"off\",\"preset\":\"off\",\"default\":\"off\","
+      "\"color\":[0,0,0],\"alt\":[0,0,0],\"bri\":128,\"int\":0,"
+      "\"temp\":false,\"tempMs\":0,\"pack\":0}]}",
+      json);
+  TEST_ASSERT_TRUE(
+      StatusLed::serializeChanges(leds, 5, StatusLed::SerialFormat::Json, &out).ok());
+  TEST_ASSERT_EQUAL_STRING("{\"since\":5,\"version\":5,\"changes\":[]}", json);
+
+  // Measure only, then a buffer that is one byte short.
+  StatusLed::SerialOutput measure;
+  TEST_ASSERT_TRUE(
+      StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &measure).ok());
+  TEST_ASSERT_TRUE(measure.written > 0);
+  out.capacity = measure.written - 1;
+  StatusLed::Status st = StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &out);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::OUT_OF_MEMORY),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(measure.written), st.detail);
+  out.capacity = measure.written;
+  TEST_ASSERT_TRUE(StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &out).ok());
+
+  // Bad outputs and an uninitialized engine are rejected.
+  StatusLed::SerialOutput both;
+  both.buffer = out.buffer;
+  both.capacity = out.capacity;
+  both.sink = capture_sink;
+  st = StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &both);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  st = StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, nullptr);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  leds.end();
+  st = StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &out);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::NOT_INITIALIZED),
+                           static_cast<uint16_t>(st.code));
+
+  TEST_ASSERT_EQUAL_STRING("flicker", StatusLed::modeName(StatusLed::Mode::FlickerCandle));
+  TEST_ASSERT_EQUAL_STRING("spatial", StatusLed::modeName(StatusLed::Mode::Spatial));
+  TEST_ASSERT_EQUAL_STRING("lowbat", StatusLed::presetName(StatusLed::StatusPreset::LowBattery));
+  TEST_ASSERT_EQUAL_STRING("unknown", StatusLed::presetName(static_cast<StatusLed::StatusPreset>(99)));
+}
+
+static void test_serializer_cbor_and_sink_chunking() {
+  StatusLed::StatusLed leds;
+  make_serializer_engine(leds);
+  TEST_ASSERT_TRUE(leds.setPreset(1, StatusLed::StatusPreset::Warning).ok());
+
+  uint8_t cbor[512];
+  StatusLed::SerialOutput out;
+  out.buffer = cbor;
+  out.capacity = sizeof(cbor);
+  TEST_ASSERT_TRUE(StatusLed::serializeState(leds, StatusLed::SerialFormat::Cbor, &out).ok());
+  TEST_ASSERT_EQUAL_UINT32(out.written, cbor_item_size(cbor, out.written));
+  // {"version": 6, ...
+  TEST_ASSERT_EQUAL_UINT32(6, leds.stateVersion());
+  const uint8_t head[] = {0xA3, 0x67, 'v', 'e', 'r', 's', 'i', 'o', 'n', 0x06};
+  TEST_ASSERT_EQUAL_MEMORY(head, cbor, sizeof(head));
+
+  // Changes use an indefinite-length array.
+  TEST_ASSERT_TRUE(
+      StatusLed::serializeChanges(leds, 0, StatusLed::SerialFormat::Cbor, &out).ok());
+  TEST_ASSERT_EQUAL_UINT32(out.written, cbor_item_size(cbor, out.written));
+  TEST_ASSERT_EQUAL_UINT8(0xFF, cbor[out.written - 1]);  // "changes" is the last member
+  const size_t cborChanges = out.written;
+
+  // A sink sees the same bytes in chunks of at most kSerialChunkSize.
+  SinkCapture capture;
+  StatusLed::SerialOutput sinkOut;
+  sinkOut.sink = capture_sink;
+  sinkOut.user = &capture;
+  TEST_ASSERT_TRUE(
+      StatusLed::serializeChanges(leds, 0, StatusLed::SerialFormat::Cbor, &sinkOut).ok());
+  TEST_ASSERT_EQUAL_UINT32(cborChanges, sinkOut.written);
+  TEST_ASSERT_EQUAL_UINT32(cborChanges, capture.len);
+  TEST_ASSERT_EQUAL_MEMORY(cbor, capture.data, cborChanges);
+  TEST_ASSERT_TRUE(capture.calls > 1);
+  TEST_ASSERT_TRUE(capture.largest <= StatusLed::kSerialChunkSize);
+
+  // A sink that gives up stops the writer.
+  SinkCapture failing;
+  failing.failAfter = 2;
+  sinkOut.user = &failing;
+  const StatusLed::Status st =
+      StatusLed::serializeState(leds, StatusLed::SerialFormat::Json, &sinkOut);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::EXTERNAL_LIB_ERROR),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(2, failing.calls);
+  leds.end();
+}
+
+static bool count_sink(const uint8_t*, size_t len, void* user) {
+  *static_cast<size_t*>(user) += len;
+  return true;
+}
+
+struct SerializerStackRun {
+  StatusLed::StatusLed* leds = nullptr;
+  bool run = false;
+};
+
+static void* serializer_stack_thread(void* arg) {
+  SerializerStackRun* r = static_cast<SerializerStackRun*>(arg);
+  if (r->run) {
+    size_t total = 0;
+    StatusLed::SerialOutput out;
+    out.sink = count_sink;
+    out.user = &total;
+    StatusLed::serializeState(*r->leds, StatusLed::SerialFormat::Json, &out);
+    StatusLed::serializeChanges(*r->leds, 0, StatusLed::SerialFormat::Cbor, &out);
+  }
+  return nullptr;
+}
+
+// Deepest stack use of a thread running on a painted stack (-1 if unsupported).
+static long painted_stack_use(SerializerStackRun* run) {
+#if defined(__unix__) || defined(__APPLE__)
+  static constexpr size_t kStackBytes = 256 * 1024;
+  static uint8_t stack[kStackBytes] __attribute__((aligned(64)));
+  memset(stack, 0xA5, sizeof(stack));
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_t thread;
+  const bool started = pthread_attr_setstack(&attr, stack, sizeof(stack)) == 0 &&
+                       pthread_create(&thread, &attr, serializer_stack_thread, run) == 0;
+  pthread_attr_destroy(&attr);
+  if (!started) {
+    return -1;
+  }
+  pthread_join(thread, nullptr);
+  size_t untouched = 0;
+  while (untouched < sizeof(stack) && stack[untouched] == 0xA5) {
+    ++untouched;
+  }
+  return static_cast<long>(sizeof(stack) - untouched);
+#else
+  (void)run;
+  return -1;
+#endif
+}
+
+static void test_serializer_throughput_and_stack_benchmark() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = StatusLed::StatusLed::kMaxLedCount;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  for (uint8_t i = 0; i < cfg.ledCount; ++i) {
+    TEST_ASSERT_TRUE(leds.setPreset(i, static_cast<StatusLed::StatusPreset>(i + 1)).ok());
+  }
+
+  const StatusLed::SerialFormat formats[] = {StatusLed::SerialFormat::Json,
+                                             StatusLed::SerialFormat::Cbor};
+  const char* const names[] = {"json", "cbor"};
+  for (size_t f = 0; f < 2; ++f) {
+    uint8_t buffer[2048];
+    StatusLed::SerialOutput out;
+    out.buffer = buffer;
+    out.capacity = sizeof(buffer);
+    const int iterations = 2000;
+    size_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      TEST_ASSERT_TRUE(StatusLed::serializeState(leds, formats[f], &out).ok());
+      bytes += out.written;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    char msg[112];
+    snprintf(msg, sizeof(msg), "serialize %s state (%u leds): %lu bytes, %.1f MB/s",
+             names[f], cfg.ledCount, static_cast<unsigned long>(out.written),
+             seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0);
+    TEST_MESSAGE(msg);
+  }
+
+  SerializerStackRun idle;
+  SerializerStackRun busy;
+  busy.leds = &leds;
+  busy.run = true;
+  const long baseline = painted_stack_use(&idle);
+  const long used = painted_stack_use(&busy);
+  char msg[112];
+  if (baseline < 0 || used < 0) {
+    snprintf(msg, sizeof(msg), "serializer stack: not measurable on this host");
+  } else {
+    snprintf(msg, sizeof(msg), "serializer max stack: %ld bytes (thread baseline %ld excluded)",
+             used - baseline, baseline);
+    TEST_ASSERT_TRUE(used >= baseline);
+  }
+  TEST_MESSAGE(msg);
+  leds.end();
+}
+
+static void test_scene_applies_atomically_in_one_frame() {
+  // constexpr proves the table is constant-initialized (flash on ESP32).
+  static constexpr StatusLed::SceneLed kMaintenance[] = {
+      {StatusLed::StatusPreset::Ready},
+      {StatusLed::Mode::Solid, StatusLed::RgbColor(0, 0, 200), StatusLed::RgbColor(), 128,
+       StatusLed::StatusPreset::Info},
+      {},
+  };
+  static constexpr StatusLed::SceneLed kBroken[] = {
+      {StatusLed::StatusPreset::Ready},
+      {StatusLed::StatusPreset::Error},
+      {StatusLed::Mode::Custom, StatusLed::RgbColor(1, 2, 3)},
+  };
+  const StatusLed::Scene maintenance{kMaintenance, 3};
+
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 3;
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  for (uint8_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_TRUE(leds.setPreset(i, StatusLed::StatusPreset::Busy).ok());
+  }
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(2, StatusLed::StatusPreset::Warning, 5000).ok());
+  tick_us(leds, 0);
+  tick_us(leds, 100000);
+
+  // A bad entry or size rejects the whole scene and changes nothing.
+  const uint32_t before = leds.stateVersion();
+  StatusLed::Status st = leds.applyScene(StatusLed::Scene{kBroken, 3});
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(2, st.detail);
+  st = leds.applyScene(StatusLed::Scene{kMaintenance, 2});
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(before, leds.stateVersion());
+  StatusLed::LedSnapshot snap;
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::StatusPreset::Busy),
+                          static_cast<uint8_t>(snap.preset));
+
+  // One version per LED, one frame for the whole panel.
+  tick_us(leds, 200000);
+  const uint32_t started = StatusLed::sim::stats().started;
+  TEST_ASSERT_TRUE(leds.applyScene(maintenance).ok());
+  TEST_ASSERT_EQUAL_UINT32(before + 3, leds.stateVersion());
+  TEST_ASSERT_EQUAL_UINT32(started, StatusLed::sim::stats().started);
+  tick_us(leds, 201000);
+  TEST_ASSERT_EQUAL_UINT32(started + 1, StatusLed::sim::stats().started);
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_EQUAL_UINT8(3, frame.count);
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(0, 255, 0));
+  TEST_ASSERT_TRUE(frame.pixels[1] == StatusLed::RgbColor(0, 0, 100));
+  TEST_ASSERT_TRUE(frame.pixels[2] == StatusLed::RgbColor());
+
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(0, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::StatusPreset::Ready),
+                          static_cast<uint8_t>(snap.preset));
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(1, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::Solid),
+                          static_cast<uint8_t>(snap.mode));
+  TEST_ASSERT_EQUAL_UINT8(128, snap.brightness);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::StatusPreset::Info),
+                          static_cast<uint8_t>(snap.defaultPreset));
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(2, &snap).ok());
+  TEST_ASSERT_FALSE(snap.tempActive);  // Temporary preset cancelled, not resumed later
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::Off),
+                          static_cast<uint8_t>(snap.mode));
+  tick_us(leds, 6000000);
+  TEST_ASSERT_TRUE(leds.getLedSnapshot(2, &snap).ok());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(StatusLed::Mode::Off),
+                          static_cast<uint8_t>(snap.mode));
+  leds.end();
+}
+
+static void test_power_rail_follows_idle_black_panel() {
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 2;
+  cfg.powerPin = cfg.dataPin;
+  StatusLed::StatusLed leds;
+  StatusLed::Status st = leds.begin(cfg);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  cfg.powerPin = 5;
+  cfg.powerSettleMs = 1001;
+  st = leds.begin(cfg);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  cfg.powerSettleMs = 3;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+
+  // The initial black frame goes out, then the idle rail is cut.
+  tick_us(leds, 0);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  TEST_ASSERT_TRUE(leds.isLedPowerOn());
+  tick_us(leds, 1000);
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_FALSE(leds.isLedPowerOn());
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().powerCuts);
+
+  // Changes that stay black are confirmed without powering up or sending.
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 0, 0)).ok());
+  TEST_ASSERT_TRUE(leds.setMode(0, StatusLed::Mode::Solid).ok());
+  const uint32_t dark = leds.stateVersion();
+  tick_us(leds, 5000);
+  tick_us(leds, 6000);
+  TEST_ASSERT_TRUE(leds.isDisplayed(dark));
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+
+  // A visible frame powers the rail, waits the settle time, then retransmits.
+  TEST_ASSERT_TRUE(leds.setPreset(1, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 10000);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(10000, StatusLed::sim::railOnUs());
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  tick_us(leds, 12000);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().started);
+  tick_us(leds, 13000);
+  TEST_ASSERT_EQUAL_UINT32(2, StatusLed::sim::stats().started);
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.startUs - StatusLed::sim::railOnUs() >= 3000u);
+  TEST_ASSERT_TRUE(frame.pixels[1] == StatusLed::RgbColor(0, 255, 0));
+
+  // A static visible panel keeps power; an animated one keeps it through dark phases.
+  for (uint32_t t = 14000; t <= 100000; t += 1000) {
+    tick_us(leds, t);
+  }
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  TEST_ASSERT_TRUE(leds.setPreset(1, StatusLed::StatusPreset::Warning).ok());  // BlinkSlow
+  for (uint32_t t = 101000; t <= 2500000; t += 1000) {
+    tick_us(leds, t);
+    TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  }
+
+  // Back to all black: cut only after the black frame was displayed.
+  TEST_ASSERT_TRUE(leds.setPreset(1, StatusLed::StatusPreset::Off).ok());
+  const uint32_t started = StatusLed::sim::stats().started;
+  tick_us(leds, 2501000);  // Blink was lit: a black frame is needed
+  TEST_ASSERT_EQUAL_UINT32(started + 1, StatusLed::sim::stats().started);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  tick_us(leds, 2502000);
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_TRUE(StatusLed::sim::lastLatched(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[1] == StatusLed::RgbColor());
+
+  const StatusLed::sim::SimStats stats = StatusLed::sim::stats();
+  TEST_ASSERT_EQUAL_UINT32(2, stats.powerOffs);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.powerOns);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.unpoweredFrames);
+  TEST_ASSERT_EQUAL_UINT32(2, leds.getFrameStats().powerCuts);
+  leds.end();
+}
+
+static void test_frame_done_callback_fires_on_completion() {
+  StatusLed::StatusLed leds;
+  uint32_t done = 0;
+  StatusLed::Status st = leds.setFrameDoneCallback(&count_frame_done, &done);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::NOT_INITIALIZED),
+                           static_cast<uint16_t>(st.code));
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setFrameDoneCallback(&count_frame_done, &done).ok());
+
+  // Fires when the frame latches, before the engine looks at the wire again.
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 0);
+  StatusLed::sim::setTimeUs(100);
+  TEST_ASSERT_EQUAL_UINT32(0, done);
+  StatusLed::sim::setTimeUs(110);
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  TEST_ASSERT_FALSE(leds.isDisplayed(leds.stateVersion()));
+  tick_us(leds, 110);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+
+  // Lost completions stay silent; the stall deadline recovers them as before.
+  StatusLed::sim::loseCompletions(1);
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Error).ok());
+  tick_us(leds, 1000);
+  tick_us(leds, 30000);
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  TEST_ASSERT_EQUAL_UINT32(1, StatusLed::sim::stats().doneCallbacks);
+
+  // Cleared by end().
+  leds.end();
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  tick_us(leds, 40000);
+  tick_us(leds, 41000);
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  leds.end();
+}
+
+static void test_chain_pins_validated_and_shorten_wire_time() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 10;
+  cfg.chainLength = 5;
+  cfg.chainPins[1] = 4;  // Gap: chainPins[0] unset
+  const uint16_t invalid = static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG);
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.chainPins[0] = 4;  // Duplicate
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.chainPins[1] = -1;
+  cfg.chainPins[0] = cfg.dataPin;
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.chainPins[0] = 4;
+  cfg.chainLength = 10;  // Second chain would be empty
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.chainLength = 5;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+
+  // Two chains of 5 shift in parallel: the frame takes half the wire time.
+  tick_us(leds, 0);
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_EQUAL_UINT8(10, frame.count);
+  TEST_ASSERT_EQUAL_UINT32(5 * 30 + 80, frame.latchUs);
+  leds.end();
+}
+
+static void test_idle_policy_dims_and_restores_on_change() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 3;
+  cfg.idleTimeoutMs = 86400001u;
+  const uint16_t invalid = static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG);
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.idleTimeoutMs = 1000;
+  cfg.idleFadeMs = 60001;
+  TEST_ASSERT_EQUAL_UINT16(invalid, static_cast<uint16_t>(leds.begin(cfg).code));
+  cfg.idleFadeMs = 100;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(2, StatusLed::StatusPreset::Ready).ok());
+  TEST_ASSERT_TRUE(leds.setTemporaryPreset(1, StatusLed::StatusPreset::Ready, 10000).ok());
+
+  // Full output until the timeout, then a ramp down to blank; the temporary
+  // preset is exempt and stays lit.
+  tick_us(leds, 0);
+  tick_us(leds, 999000);
+  TEST_ASSERT_EQUAL_UINT8(255, leds.idleOutputLevel());
+  tick_us(leds, 1000000);
+  tick_us(leds, 1050000);
+  TEST_ASSERT_EQUAL_UINT8(128, leds.idleOutputLevel());
+  StatusLed::sim::SimFrame frame;
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(0, 128, 0));
+  tick_us(leds, 1100000);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.idleOutputLevel());
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor());
+  TEST_ASSERT_TRUE(frame.pixels[1] == StatusLed::RgbColor(0, 255, 0));
+  TEST_ASSERT_TRUE(frame.pixels[2] == StatusLed::RgbColor());
+
+  // At the floor nothing is scheduled: later ticks send nothing.
+  const uint32_t started = StatusLed::sim::stats().started;
+  tick_us(leds, 5000000);
+  TEST_ASSERT_EQUAL_UINT32(started, StatusLed::sim::stats().started);
+
+  // A new status restores full output at once and restarts the timer.
+  TEST_ASSERT_TRUE(leds.setPreset(2, StatusLed::StatusPreset::Busy).ok());
+  TEST_ASSERT_EQUAL_UINT8(255, leds.idleOutputLevel());
+  tick_us(leds, 5001000);
+  TEST_ASSERT_TRUE(StatusLed::sim::lastStarted(&frame));
+  TEST_ASSERT_TRUE(frame.pixels[0] == StatusLed::RgbColor(0, 255, 0));
+  tick_us(leds, 5999000);
+  TEST_ASSERT_EQUAL_UINT8(255, leds.idleOutputLevel());
+  tick_us(leds, 6000000);
+  tick_us(leds, 6100000);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.idleOutputLevel());
+
+  // The temporary preset ending is a state change too.
+  tick_us(leds, 10000000);
+  TEST_ASSERT_EQUAL_UINT8(255, leds.idleOutputLevel());
+  leds.end();
+
+  // Blank with a power pin: the rail is cut once the black frame is shown.
+  cfg.ledCount = 1;
+  cfg.powerPin = 5;
+  cfg.idleFadeMs = 0;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 20000000);
+  tick_us(leds, 20001000);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+  tick_us(leds, 21000000);
+  tick_us(leds, 21001000);
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Busy).ok());
+  tick_us(leds, 21002000);
+  TEST_ASSERT_TRUE(StatusLed::sim::railPowered());
+
+  // An animated LED blanked by the idle policy does not hold the rail on.
+  tick_us(leds, 22002000);
+  tick_us(leds, 22003000);
+  TEST_ASSERT_EQUAL_UINT8(0, leds.idleOutputLevel());
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(2, leds.getFrameStats().powerCuts);
+  const uint32_t blanked = StatusLed::sim::stats().started;
+  for (uint32_t t = 22010000; t <= 24000000; t += 10000) {
+    tick_us(leds, t);
+  }
+  TEST_ASSERT_FALSE(StatusLed::sim::railPowered());
+  TEST_ASSERT_EQUAL_UINT32(blanked, StatusLed::sim::stats().started);
+  leds.end();
+
+  // Disabled by default: output never changes.
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  tick_us(leds, 30000000);
+  tick_us(leds, 900000000);
+  TEST_ASSERT_EQUAL_UINT8(255, leds.idleOutputLevel());
+  leds.end();
+}
+
+#endif  // STATUSLED_BACKEND_NULL
+
+#if STATUSLED_BACKEND_IDF5_WS2812 || STATUSLED_BACKEND_IDF_WS2812
+
+// Bytes the LEDs receive for a frame, in wire (GRB) order.
+static size_t expected_wire(const StatusLed::RgbColor* frame, uint8_t count, uint8_t* out) {
+  size_t n = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    out[n++] = frame[i].g;
+    out[n++] = frame[i].r;
+    out[n++] = frame[i].b;
+  }
+  return n;
+}
+
+#endif
+
+#if STATUSLED_BACKEND_IDF5_WS2812
+
+static void check_wire(const StatusLed::RgbColor* frame, uint8_t count) {
+  uint8_t expected[idfmock::kMaxWireBytes];
+  const size_t n = expected_wire(frame, count, expected);
+  const idfmock::Transmission& tx = idfmock::state().last;
+  TEST_ASSERT_TRUE(tx.symbolsValid);
+  TEST_ASSERT_EQUAL_UINT32(n, tx.wireBytes);
+  TEST_ASSERT_EQUAL_MEMORY(expected, tx.wire, n);
+}
+
+static void test_idf5_uniform_frame_uses_hw_loop() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 8;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  TEST_ASSERT_TRUE(leds.setAllPreset(StatusLed::StatusPreset::Info).ok());
+  leds.tick(0);
+
+  StatusLed::RgbColor frame[8];
+  for (uint8_t i = 0; i < 8; ++i) {
+    frame[i] = StatusLed::RgbColor(0, 0, 255);
+  }
+  const idfmock::Transmission& tx = idfmock::state().last;
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().transmits);
+  TEST_ASSERT_EQUAL_UINT32(3, tx.payloadBytes);
+  TEST_ASSERT_EQUAL_INT(8, tx.loopCount);
+  TEST_ASSERT_EQUAL_UINT32(24, tx.encodedSymbols);
+  check_wire(frame, 8);
+
+  // Any differing pixel falls back to a full frame with identical wire output.
+  idfmock::completeTx();
+  TEST_ASSERT_TRUE(leds.setPreset(5, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(1);
+  frame[5] = StatusLed::RgbColor(0, 255, 0);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().transmits);
+  TEST_ASSERT_EQUAL_UINT32(24, tx.payloadBytes);
+  TEST_ASSERT_EQUAL_INT(0, tx.loopCount);
+  check_wire(frame, 8);
+
+  // end() blanks the chain through the looped path.
+  idfmock::completeTx();
+  leds.end();
+  for (uint8_t i = 0; i < 8; ++i) {
+    frame[i] = StatusLed::RgbColor(0, 0, 0);
+  }
+  TEST_ASSERT_EQUAL_INT(8, tx.loopCount);
+  check_wire(frame, 8);
+}
+
+static void test_idf5_single_led_is_not_looped() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(0);
+  const StatusLed::RgbColor frame[1] = {StatusLed::RgbColor(0, 255, 0)};
+  TEST_ASSERT_EQUAL_INT(0, idfmock::state().last.loopCount);
+  check_wire(frame, 1);
+  idfmock::completeTx();
+  leds.end();
+}
+
+// Show one frame, then move the clock to just before the 1-LED transmit deadline.
+static const int64_t kIdf5DeadlineUs = 30 + 300 + 20000;
+
+static void start_frame_near_deadline(StatusLed::StatusLed& leds, const StatusLed::RgbColor& color) {
+  TEST_ASSERT_TRUE(leds.setMode(0, StatusLed::Mode::Solid).ok());
+  TEST_ASSERT_TRUE(leds.setColor(0, color).ok());
+  leds.tick(0);
+  TEST_ASSERT_TRUE(idfmock::busy());
+  idfmock::setTimeUs(kIdf5DeadlineUs - 1);
+}
+
+static void test_idf5_lost_done_callback_recovers() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  idfmock::state().dropDoneCallback = true;
+  start_frame_near_deadline(leds, StatusLed::RgbColor(255, 0, 0));
+  idfmock::completeTx();  // Frame finished; on_trans_done never ran
+  idfmock::state().dropDoneCallback = false;
+
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 0, 255)).ok());
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().transmits);
+  idfmock::setTimeUs(kIdf5DeadlineUs);
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().disables);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().transmits);
+  const StatusLed::RgbColor frame[1] = {StatusLed::RgbColor(0, 0, 255)};
+  check_wire(frame, 1);
+  idfmock::completeTx();
+  leds.end();
+}
+
+static void test_idf5_hung_channel_is_reset_or_reinstalled() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  idfmock::state().hung = true;
+  start_frame_near_deadline(leds, StatusLed::RgbColor(255, 0, 0));
+
+  // Disable/enable clears the stuck transaction; the latch holdoff delays the next frame.
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 0, 255)).ok());
+  idfmock::setTimeUs(kIdf5DeadlineUs);
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().disables);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().transmits);
+  idfmock::setTimeUs(kIdf5DeadlineUs + 300);
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().transmits);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().channelsCreated);
+
+  // If the channel cannot be re-enabled it is rebuilt, retrying until that
+  // succeeds; the stall is counted once, when it is recovered.
+  idfmock::state().hung = true;
+  idfmock::state().enableFails = true;
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 255, 0)).ok());
+  idfmock::setTimeUs(2 * kIdf5DeadlineUs + 300);
+  leds.tick(40);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::HARDWARE_FAULT),
+                           static_cast<uint16_t>(leds.getLastStatus().code));
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().transmits);
+  idfmock::state().enableFails = false;
+  leds.tick(41);
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().channelsCreated);  // Failed rebuild, then success
+  TEST_ASSERT_EQUAL_UINT32(2, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().transmits);
+  const StatusLed::RgbColor frame[1] = {StatusLed::RgbColor(0, 255, 0)};
+  check_wire(frame, 1);
+  idfmock::completeTx();
+  leds.end();
+}
+
+static void test_idf5_display_ack_uses_completion_time() {
+  StatusLed::StatusLed leds;
+  uint32_t done = 0;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setFrameDoneCallback(&count_frame_done, &done).ok());
+  leds.tick(0);
+  idfmock::completeTx();
+  idfmock::setTimeUs(1000);
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(1);
+  idfmock::setTimeUs(1500);
+  idfmock::completeTx();  // on_trans_done timestamps the completion
+  idfmock::setTimeUs(9000);
+  leds.tick(9);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+  TEST_ASSERT_EQUAL_UINT32(1000, leds.lastDisplayAck().changeUs);
+  TEST_ASSERT_EQUAL_UINT32(1500 + 300, leds.lastDisplayAck().displayedUs);
+  TEST_ASSERT_EQUAL_UINT32(800, leds.lastDisplayAck().latencyUs);
+  TEST_ASSERT_EQUAL_UINT32(2, done);
+  leds.end();
+}
+
+// 10 LEDs on three data pins: chains of 4, 4 and 2.
+static StatusLed::Config make_chain_config() {
+  StatusLed::Config cfg = make_config();
+  cfg.ledCount = 10;
+  cfg.chainPins[0] = 4;
+  cfg.chainPins[1] = 5;
+  cfg.chainLength = 4;
+  return cfg;
+}
+
+static void check_chain_wire(size_t channel, const StatusLed::RgbColor* frame, uint8_t count) {
+  uint8_t expected[idfmock::kMaxWireBytes];
+  const size_t n = expected_wire(frame, count, expected);
+  const idfmock::Transmission& tx = idfmock::state().channels[channel].last;
+  TEST_ASSERT_TRUE(tx.symbolsValid);
+  TEST_ASSERT_EQUAL_INT(0, tx.loopCount);
+  TEST_ASSERT_EQUAL_UINT32(n, tx.wireBytes);
+  TEST_ASSERT_EQUAL_MEMORY(expected, tx.wire, n);
+}
+
+static void test_idf5_chains_start_together() {
+  StatusLed::StatusLed leds;
+  uint32_t done = 0;
+  TEST_ASSERT_TRUE(leds.begin(make_chain_config()).ok());
+  TEST_ASSERT_TRUE(leds.setFrameDoneCallback(&count_frame_done, &done).ok());
+  TEST_ASSERT_TRUE(idfmock::state().syncCreated);
+  TEST_ASSERT_EQUAL_UINT8(0x07, idfmock::state().syncMask);
+  const int pins[3] = {1, 4, 5};
+  for (size_t c = 0; c < 3; ++c) {
+    TEST_ASSERT_EQUAL_INT(pins[c], idfmock::state().channels[c].gpio);
+    TEST_ASSERT_EQUAL_UINT32(48, idfmock::state().channels[c].memBlockSymbols);
+  }
+
+  StatusLed::RgbColor frame[10];
+  for (uint8_t i = 0; i < 10; ++i) {
+    frame[i] = StatusLed::RgbColor(static_cast<uint8_t>(10 + i), 0, static_cast<uint8_t>(i));
+    TEST_ASSERT_TRUE(leds.setColor(i, frame[i]).ok());
+    TEST_ASSERT_TRUE(leds.setMode(i, StatusLed::Mode::Solid).ok());
+  }
+  leds.tick(0);
+
+  // Queued chain by chain, started once, together, after the last one.
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().transmits);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().syncStarts);
+  for (size_t c = 0; c < 3; ++c) {
+    TEST_ASSERT_EQUAL_UINT32(c + 1, idfmock::state().channels[c].queuedSeq);
+    TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().channels[c].startSeq);
+  }
+  check_chain_wire(0, &frame[0], 4);
+  check_chain_wire(1, &frame[4], 4);
+  check_chain_wire(2, &frame[8], 2);
+
+  // The frame completes with its longest chain.
+  idfmock::completeChannel(2);
+  leds.tick(1);
+  TEST_ASSERT_FALSE(leds.isDisplayed(leds.stateVersion()));
+  TEST_ASSERT_EQUAL_UINT32(0, done);
+  idfmock::completeChannel(0);
+  idfmock::completeChannel(1);
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  leds.tick(2);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+
+  // Uniform frames are not looped across a group.
+  TEST_ASSERT_TRUE(leds.setAllPreset(StatusLed::StatusPreset::Info).ok());
+  leds.tick(3);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().syncStarts);
+  for (uint8_t i = 0; i < 10; ++i) {
+    frame[i] = StatusLed::RgbColor(0, 0, 255);
+  }
+  check_chain_wire(0, &frame[0], 4);
+  check_chain_wire(2, &frame[8], 2);
+  idfmock::completeTx();
+
+  // end() blanks all chains and removes the group before its channels.
+  leds.end();
+  for (size_t c = 0; c < idfmock::kMaxChannels; ++c) {
+    TEST_ASSERT_FALSE(idfmock::state().channels[c].created);
+  }
+  TEST_ASSERT_FALSE(idfmock::state().syncCreated);
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().syncStarts);
+}
+
+static void test_idf5_chain_errors_leave_group_consistent() {
+  StatusLed::StatusLed leds;
+  StatusLed::Config cfg = make_chain_config();
+
+  // A failed group setup releases every channel.
+  idfmock::state().syncError = ESP_ERR_NO_MEM;
+  StatusLed::Status st = leds.begin(cfg);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::HARDWARE_FAULT),
+                           static_cast<uint16_t>(st.code));
+  for (size_t c = 0; c < idfmock::kMaxChannels; ++c) {
+    TEST_ASSERT_FALSE(idfmock::state().channels[c].created);
+  }
+  idfmock::state().syncError = ESP_OK;
+
+  cfg.chainLength = 3;  // 3 + 3 + 3 < 10
+  st = leds.begin(cfg);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::INVALID_CONFIG),
+                           static_cast<uint16_t>(st.code));
+  cfg.chainLength = 4;
+  TEST_ASSERT_TRUE(leds.begin(cfg).ok());
+  leds.tick(0);
+  idfmock::completeTx();
+
+  // The second chain refuses its transaction: the first is dropped before it
+  // ever starts and the group is rearmed.
+  idfmock::state().nextTransmitError = ESP_FAIL;
+  idfmock::state().transmitErrorAfter = 1;
+  TEST_ASSERT_TRUE(leds.setPreset(9, StatusLed::StatusPreset::Error).ok());
+  leds.tick(1);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().showErrors);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().syncStarts);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().syncResets);
+  TEST_ASSERT_FALSE(idfmock::busy());
+
+  // The frame stays dirty and goes out whole on the next tick.
+  leds.tick(2);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().syncStarts);
+  StatusLed::RgbColor tail[2] = {StatusLed::RgbColor(), StatusLed::RgbColor(255, 0, 0)};
+  check_chain_wire(2, tail, 2);
+  idfmock::completeTx();
+  leds.tick(3);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+
+  // If the group cannot be rearmed either, the channels are rebuilt on the
+  // next tick: a driver error, not a stalled transmit.
+  idfmock::state().nextTransmitError = ESP_FAIL;
+  idfmock::state().transmitErrorAfter = 1;
+  idfmock::state().enableFails = true;
+  TEST_ASSERT_TRUE(leds.setPreset(9, StatusLed::StatusPreset::Warning).ok());
+  leds.tick(3);
+  TEST_ASSERT_EQUAL_UINT32(2, leds.getFrameStats().showErrors);
+  TEST_ASSERT_FALSE(idfmock::state().channels[0].created);
+  idfmock::state().enableFails = false;
+  leds.tick(3);
+  TEST_ASSERT_EQUAL_UINT32(0, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::EXTERNAL_LIB_ERROR),
+                           static_cast<uint16_t>(leds.getLastStatus().code));
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().syncStarts);
+  idfmock::completeTx();
+  leds.tick(3);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+
+  // A hung group is reset as a whole.
+  idfmock::state().hung = true;
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(4);
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Busy).ok());
+  idfmock::setTimeUs(4 * 30 + 300 + 20000);
+  leds.tick(25);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().syncResets);
+  TEST_ASSERT_FALSE(idfmock::busy());
+  leds.end();
+}
+
+#endif  // STATUSLED_BACKEND_IDF5_WS2812
+
+#if STATUSLED_BACKEND_IDF_WS2812
+
+static void check_legacy_wire(const StatusLed::RgbColor* frame, uint8_t count) {
+  uint8_t expected[idfmock::kMaxWireBytes];
+  const size_t n = expected_wire(frame, count, expected);
+  TEST_ASSERT_TRUE(idfmock::state().itemsValid);
+  TEST_ASSERT_EQUAL_UINT32(n, idfmock::state().wireBytes);
+  TEST_ASSERT_EQUAL_MEMORY(expected, idfmock::state().wire, n);
+}
+
+static uint32_t g_foreignTxEnds = 0;
+
+// Another component's tx-end callback, registered before begin().
+static void foreign_tx_end(rmt_channel_t, void* arg) {
+  (void)arg;
+  ++g_foreignTxEnds;
+}
+
+static void test_idf_tx_end_callback_drives_busy_state() {
+  g_foreignTxEnds = 0;
+  rmt_register_tx_end_callback(&foreign_tx_end, nullptr);
+  StatusLed::StatusLed leds;
+  uint32_t done = 0;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(leds.setFrameDoneCallback(&count_frame_done, &done).ok());
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(0);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().writes);
+  TEST_ASSERT_TRUE(idfmock::state().channels[0].busy);
+
+  // While busy, ticks neither poll the driver nor queue behind the frame.
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 0, 255)).ok());
+  for (uint32_t ms = 1; ms <= 5; ++ms) {
+    leds.tick(ms);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().waitCalls);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().writes);
+  TEST_ASSERT_FALSE(leds.isDisplayed(leds.stateVersion()));
+
+  // The interrupt frees the channel, notifies, and chains to the earlier callback.
+  idfmock::setTimeUs(5000);
+  idfmock::completeTx();
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  TEST_ASSERT_EQUAL_UINT32(1, g_foreignTxEnds);
+  idfmock::setTimeUs(6000);
+  leds.tick(6);
+  TEST_ASSERT_EQUAL_UINT32(5000 + 80, leds.lastDisplayAck().displayedUs);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().writes);
+  const StatusLed::RgbColor frame[1] = {StatusLed::RgbColor(0, 0, 255)};
+  check_legacy_wire(frame, 1);
+
+  // Frames on other channels pass through untouched.
+  idfmock::state().txEnd.function(RMT_CHANNEL_1, idfmock::state().txEnd.arg);
+  TEST_ASSERT_EQUAL_UINT32(1, done);
+  TEST_ASSERT_EQUAL_UINT32(2, g_foreignTxEnds);
+  TEST_ASSERT_TRUE(idfmock::state().channels[0].busy);
+
+  idfmock::completeTx();
+  leds.tick(7);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().waitCalls);
+  leds.end();
+  TEST_ASSERT_TRUE(idfmock::state().txEnd.function == &foreign_tx_end);
+}
+
+// Show one frame, then move the clock to just before the 1-LED transmit deadline.
+static const int64_t kIdfDeadlineUs = 30 + 80 + 20000;
+
+static void test_idf_lost_tx_end_callback_recovers() {
+  StatusLed::StatusLed leds;
+  TEST_ASSERT_TRUE(leds.begin(make_config()).ok());
+  idfmock::state().dropTxEnd = true;
+  TEST_ASSERT_TRUE(leds.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  leds.tick(0);
+  idfmock::completeTx();  // Frame finished; the tx-end callback never ran
+  idfmock::state().dropTxEnd = false;
+
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(255, 0, 0)).ok());
+  idfmock::setTimeUs(kIdfDeadlineUs - 1);
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(1, idfmock::state().writes);
+  idfmock::setTimeUs(kIdfDeadlineUs);
+  leds.tick(20);
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().stops);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().writes);
+  const StatusLed::RgbColor red[1] = {StatusLed::RgbColor(255, 0, 0)};
+  check_legacy_wire(red, 1);
+
+  // A stuck transmitter (or a lost tx-end interrupt) keeps the driver's tx
+  // semaphore taken: the channel is rebuilt and the next frame goes out.
+  idfmock::state().channels[0].hung = true;
+  TEST_ASSERT_TRUE(leds.setColor(0, StatusLed::RgbColor(0, 255, 0)).ok());
+  idfmock::state().nextInstallError = ESP_FAIL;
+  idfmock::setTimeUs(2 * kIdfDeadlineUs);
+  leds.tick(40);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(StatusLed::Err::HARDWARE_FAULT),
+                           static_cast<uint16_t>(leds.getLastStatus().code));
+  TEST_ASSERT_EQUAL_UINT32(1, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_FALSE(idfmock::state().channels[0].installed);
+  leds.tick(41);  // The failed rebuild is retried
+  TEST_ASSERT_EQUAL_UINT32(2, leds.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(2, idfmock::state().installs);
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().stops);
+  TEST_ASSERT_EQUAL_UINT32(0, idfmock::state().blockedWrites);
+  TEST_ASSERT_EQUAL_UINT32(3, idfmock::state().writes);
+  const StatusLed::RgbColor green[1] = {StatusLed::RgbColor(0, 255, 0)};
+  check_legacy_wire(green, 1);
+
+  // The rebuilt channel is routed to the shared tx-end callback again.
+  idfmock::completeTx();
+  leds.tick(42);
+  TEST_ASSERT_TRUE(leds.isDisplayed(leds.stateVersion()));
+  leds.end();
+}
+
+static void test_idf_two_instances_share_tx_end_callback() {
+  StatusLed::StatusLed a;
+  StatusLed::StatusLed b;
+  StatusLed::Config cfgB = make_config();
+  cfgB.dataPin = 2;
+  cfgB.rmtChannel = 1;
+  TEST_ASSERT_TRUE(a.begin(make_config()).ok());
+  TEST_ASSERT_TRUE(b.begin(cfgB).ok());
+  uint32_t doneB = 0;
+  TEST_ASSERT_TRUE(b.setFrameDoneCallback(&count_frame_done, &doneB).ok());
+
+  // Each channel's completion reaches only its own instance.
+  TEST_ASSERT_TRUE(a.setPreset(0, StatusLed::StatusPreset::Ready).ok());
+  TEST_ASSERT_TRUE(b.setPreset(0, StatusLed::StatusPreset::Error).ok());
+  a.tick(0);
+  b.tick(0);
+  idfmock::completeTx(RMT_CHANNEL_1);
+  TEST_ASSERT_EQUAL_UINT32(1, doneB);
+  TEST_ASSERT_TRUE(idfmock::state().channels[0].busy);
+  idfmock::completeTx(RMT_CHANNEL_0);
+  TEST_ASSERT_EQUAL_UINT32(1, doneB);
+
+  // Ending the first instance leaves the second one's completions working.
+  a.end();
+  const uint32_t waitCalls = idfmock::state().waitCalls;
+  TEST_ASSERT_TRUE(idfmock::state().txEnd.function != nullptr);
+  TEST_ASSERT_TRUE(b.setColor(0, StatusLed::RgbColor(0, 0, 255)).ok());
+  idfmock::setTimeUs(2 * kIdfDeadlineUs);
+  b.tick(40);
+  TEST_ASSERT_TRUE(idfmock::state().channels[1].busy);
+  idfmock::completeTx(RMT_CHANNEL_1);
+  TEST_ASSERT_EQUAL_UINT32(2, doneB);
+  b.tick(41);
+  TEST_ASSERT_TRUE(b.isDisplayed(b.stateVersion()));
+  TEST_ASSERT_EQUAL_UINT32(0, b.getFrameStats().txTimeouts);
+  TEST_ASSERT_EQUAL_UINT32(waitCalls, idfmock::state().waitCalls);
+
+  // The last end() restores whatever was registered before the first begin().
+  b.end();
+  TEST_ASSERT_TRUE(idfmock::state().txEnd.function == nullptr);
+}
+
+#endif  // STATUSLED_BACKEND_IDF_WS2812
+
+void setUp() {
+#if STATUSLED_BACKEND_NULL
+  StatusLed::sim::reset();
+#elif STATUSLED_BACKEND_IDF5_WS2812 || STATUSLED_BACKEND_IDF_WS2812
+  idfmock::reset();
+#endif
+}
 void tearDown() {}
 
 int main(int, char**) {
   UNITY_BEGIN();
+#if STATUSLED_BACKEND_NULL
   RUN_TEST(test_blink_fast_toggles);
   RUN_TEST(test_temporary_preset_reverts);
   RUN_TEST(test_fade_in_oneshot);
@@ -613,5 +2961,52 @@ int main(int, char**) {
   RUN_TEST(test_set_all_mode_applies_to_all);
   RUN_TEST(test_set_all_mode_rejects_invalid);
   RUN_TEST(test_set_all_color_applies_to_all);
+  RUN_TEST(test_pack_validation_rejects_corruption);
+  RUN_TEST(test_pack_pattern_plays_steps_in_place);
+  RUN_TEST(test_pack_track_interpolates_and_holds);
+  RUN_TEST(test_pack_file_mapping_roundtrip);
+  RUN_TEST(test_change_feed_reports_only_changed_leds);
+  RUN_TEST(test_change_feed_tracks_temporary_presets);
+  RUN_TEST(test_urgent_change_supersedes_in_flight_frame);
+  RUN_TEST(test_worst_case_change_to_wire_latency);
+  RUN_TEST(test_power_estimate_matches_simulated_trace);
+  RUN_TEST(test_power_estimate_exact_for_step_patterns);
+  RUN_TEST(test_custom_mode_matches_builtin_blink);
+  RUN_TEST(test_custom_mode_holds_until_woken);
+  RUN_TEST(test_ext_pool_fragmentation_and_exhaustion);
+  RUN_TEST(test_custom_mode_reports_ext_pool_exhaustion);
+  RUN_TEST(test_ext_pool_acquire_release_cost);
+  RUN_TEST(test_tick_visits_only_active_leds);
+  RUN_TEST(test_lost_completion_recovers_after_deadline);
+  RUN_TEST(test_lost_completion_recovers_without_new_changes);
+  RUN_TEST(test_display_ack_confirms_change_on_wire);
+  RUN_TEST(test_layout_tables_serpentine_reversed_and_map);
+  RUN_TEST(test_spatial_effects_follow_layout_distance);
+  RUN_TEST(test_frame_clock_matches_deadlines_and_batches_frames);
+  RUN_TEST(test_frame_clock_keeps_output_stage_running_between_edges);
+  RUN_TEST(test_frame_clock_crossover_benchmark);
+  RUN_TEST(test_serializer_json_state_and_changes);
+  RUN_TEST(test_serializer_cbor_and_sink_chunking);
+  RUN_TEST(test_serializer_throughput_and_stack_benchmark);
+  RUN_TEST(test_scene_applies_atomically_in_one_frame);
+  RUN_TEST(test_power_rail_follows_idle_black_panel);
+  RUN_TEST(test_frame_done_callback_fires_on_completion);
+  RUN_TEST(test_chain_pins_validated_and_shorten_wire_time);
+  RUN_TEST(test_idle_policy_dims_and_restores_on_change);
+#endif
+#if STATUSLED_BACKEND_IDF5_WS2812
+  RUN_TEST(test_idf5_uniform_frame_uses_hw_loop);
+  RUN_TEST(test_idf5_single_led_is_not_looped);
+  RUN_TEST(test_idf5_lost_done_callback_recovers);
+  RUN_TEST(test_idf5_hung_channel_is_reset_or_reinstalled);
+  RUN_TEST(test_idf5_display_ack_uses_completion_time);
+  RUN_TEST(test_idf5_chains_start_together);
+  RUN_TEST(test_idf5_chain_errors_leave_group_consistent);
+#endif
+#if STATUSLED_BACKEND_IDF_WS2812
+  RUN_TEST(test_idf_tx_end_callback_drives_busy_state);
+  RUN_TEST(test_idf_lost_tx_end_callback_recovers);
+  RUN_TEST(test_idf_two_instances_share_tx_end_callback);
+#endif
   return UNITY_END();
 }